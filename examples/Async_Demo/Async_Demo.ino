@@ -0,0 +1,70 @@
+#include <QuectelEC200U.h>
+// Set the EC200U modem RX and TX pins
+#define EC200U_RX_PIN 16
+#define EC200U_TX_PIN 17
+
+#define SENSOR_PIN A0
+
+#if defined(ARDUINO_ARCH_ESP32)
+  HardwareSerial SerialAT(1);
+  QuectelEC200U modem(SerialAT, 115200, EC200U_RX_PIN, EC200U_TX_PIN);
+#elif defined(ARDUINO_ARCH_ZEPHYR)
+  HardwareSerial& SerialAT = Serial1;
+  QuectelEC200U modem(SerialAT, 115200, EC200U_RX_PIN, EC200U_TX_PIN);
+#else
+  #include <SoftwareSerial.h>
+  SoftwareSerial SerialAT(EC200U_RX_PIN, EC200U_TX_PIN);
+  QuectelEC200U modem(SerialAT);
+#endif
+
+bool online = false;
+uint32_t lastUpload = 0;
+
+void onSignal(bool ok, const char *response, void *arg) {
+  if (ok) Serial.print(response);
+}
+
+void onAttached(bool ok, const char *response, void *arg) {
+  online = ok;
+  Serial.println(ok ? "Data attached" : "Attach failed");
+}
+
+void onRegistered(bool ok, const char *response, void *arg) {
+  if (!ok) {
+    Serial.println("No network");
+    return;
+  }
+  modem.attachDataAsync("your.apn.here", onAttached);
+}
+
+void onUploaded(bool ok, const String &body, void *arg) {
+  Serial.print("Upload ");
+  Serial.println(ok ? body : modem.getLastErrorString());
+}
+
+void setup() {
+  Serial.begin(115200);
+#if defined(ARDUINO_ARCH_ZEPHYR)
+  SerialAT.begin(115200);
+#elif !defined(ARDUINO_ARCH_ESP32)
+  SerialAT.begin(9600);
+#endif
+  modem.begin();
+
+  modem.sendATAsync("AT+CSQ", onSignal);
+  modem.waitForNetworkAsync(onRegistered);
+}
+
+void loop() {
+  // Never blocks: the modem work advances a little on every pass
+  modem.loop();
+
+  // Sampling keeps its own pace while requests are in flight
+  int sample = analogRead(SENSOR_PIN);
+
+  if (online && !modem.busy() && millis() - lastUpload > 30000) {
+    lastUpload = millis();
+    String body = String("{\"value\":") + sample + "}";
+    modem.httpPostAsync("http://example.com/telemetry", body.c_str(), onUploaded);
+  }
+}
@@ -0,0 +1,56 @@
+// Several FreeRTOS tasks sharing one modem (ESP32 only)
+#include <QuectelEC200U.h>
+// Set the EC200U modem RX and TX pins
+#define EC200U_RX_PIN 16
+#define EC200U_TX_PIN 17
+
+#if !defined(ARDUINO_ARCH_ESP32)
+#error "Worker mode requires an ESP32"
+#endif
+
+HardwareSerial SerialAT(1);
+QuectelEC200U modem(SerialAT, 115200, EC200U_RX_PIN, EC200U_TX_PIN);
+
+void onRing(const char *line, void *arg) {
+  // Runs in the modem's RX task
+  Serial.println("Incoming call");
+}
+
+void telemetryTask(void *arg) {
+  for (;;) {
+    int csq = modem.getSignalStrength();
+    Serial.printf("[telemetry] CSQ %d\n", csq);
+    vTaskDelay(pdMS_TO_TICKS(5000));
+  }
+}
+
+void clockTask(void *arg) {
+  for (;;) {
+    // Keep the modem for both commands so no other task slips in between
+    modem.lock();
+    String clock = modem.getClock();
+    String op = modem.getOperator();
+    modem.unlock();
+    Serial.printf("[clock] %s on %s\n", clock.c_str(), op.c_str());
+    vTaskDelay(pdMS_TO_TICKS(7000));
+  }
+}
+
+void setup() {
+  Serial.begin(115200);
+  modem.begin();
+  modem.onURC("RING", onRing);
+
+  if (!modem.startWorker()) {
+    Serial.println("Worker start failed");
+  }
+
+  xTaskCreate(telemetryTask, "telemetry", 4096, NULL, 1, NULL);
+  xTaskCreate(clockTask, "clock", 4096, NULL, 1, NULL);
+}
+
+void loop() {
+  // The Arduino loop task is just another client
+  Serial.printf("[loop] registered: %d\n", modem.getRegistrationStatus());
+  delay(3000);
+}
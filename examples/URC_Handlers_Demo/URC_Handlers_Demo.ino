@@ -0,0 +1,73 @@
+#include <QuectelEC200U.h>
+// Set the EC200U modem RX and TX pins
+#define EC200U_RX_PIN 16
+#define EC200U_TX_PIN 17
+
+#if defined(ARDUINO_ARCH_ESP32)
+  HardwareSerial SerialAT(1);
+  QuectelEC200U modem(SerialAT, 115200, EC200U_RX_PIN, EC200U_TX_PIN);
+#elif defined(ARDUINO_ARCH_ZEPHYR)
+  HardwareSerial& SerialAT = Serial1;
+  QuectelEC200U modem(SerialAT, 115200, EC200U_RX_PIN, EC200U_TX_PIN);
+#else
+  #include <SoftwareSerial.h>
+  SoftwareSerial SerialAT(EC200U_RX_PIN, EC200U_TX_PIN);
+  QuectelEC200U modem(SerialAT);
+#endif
+
+// Handlers run while the library is reading the UART, so they only record
+// the event; the AT work happens in loop().
+volatile int newSmsIndex = -1;
+volatile bool ringing = false;
+
+void onNewSms(const char *line, void *arg) {
+  // +CMTI: "SM",3
+  const char *comma = strrchr(line, ',');
+  if (comma) newSmsIndex = atoi(comma + 1);
+}
+
+void onRing(const char *line, void *arg) {
+  ringing = true;
+}
+
+void onSocketEvent(const char *line, void *arg) {
+  // +QIURC: "recv",0  /  +QIURC: "closed",0
+  Serial.print("Socket event: ");
+  Serial.println(line);
+}
+
+void setup() {
+  Serial.begin(115200);
+#if defined(ARDUINO_ARCH_ZEPHYR)
+  SerialAT.begin(115200);
+#elif !defined(ARDUINO_ARCH_ESP32)
+  SerialAT.begin(9600);
+#endif
+  modem.begin();
+
+  modem.onURC("+CMTI:", onNewSms);
+  modem.onURC("RING", onRing);
+  modem.onURC("+QIURC:", onSocketEvent);
+
+  // Deliver new-message indications as +CMTI
+  modem.sendAT("AT+CMGF=1");
+  modem.sendAT("AT+CNMI=2,1,0,0,0");
+}
+
+void loop() {
+  modem.poll();
+
+  if (newSmsIndex >= 0) {
+    int index = newSmsIndex;
+    newSmsIndex = -1;
+    Serial.println(modem.readSMS(index));
+  }
+
+  if (ringing) {
+    ringing = false;
+    Serial.println("Incoming call");
+  }
+
+  // Other work keeps running; URCs are picked up on the next poll()
+  delay(10);
+}
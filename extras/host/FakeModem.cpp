@@ -0,0 +1,340 @@
+/*
+  FakeModem - scriptable EC200U simulator for host builds (see FakeModem.h).
+*/
+
+#include "FakeModem.h"
+
+#include <algorithm>
+#include <sstream>
+
+FakeModem::Rule &FakeModem::Rule::line(const std::string &text) {
+  return raw(frame(text));
+}
+
+FakeModem::Rule &FakeModem::Rule::raw(const std::string &bytes) {
+  if (dataArg >= 0 || ctrlZ) {
+    afterData += bytes;
+  } else {
+    reply += bytes;
+  }
+  return *this;
+}
+
+FakeModem::Rule &FakeModem::Rule::data(int argIndex) {
+  dataArg = argIndex;
+  return *this;
+}
+
+FakeModem::Rule &FakeModem::Rule::dataUntilCtrlZ() {
+  ctrlZ = true;
+  return *this;
+}
+
+FakeModem::Rule &FakeModem::Rule::urc(uint32_t delayMs,
+                                      const std::string &text) {
+  urcs.push_back(std::make_pair(delayMs, frame(text)));
+  return *this;
+}
+
+FakeModem::Rule &FakeModem::Rule::times(int n) {
+  remaining = n;
+  return *this;
+}
+
+FakeModem::FakeModem(uint32_t baud)
+    : _defaultReply("\r\nERROR\r\n"), _dataRule(nullptr), _dataRemaining(0),
+      _dataCtrlZ(false), _skipLf(false), _baud(baud), _latencyUs(0), _lineFreeUs(0),
+      _bytesIn(0), _bytesOut(0) {}
+
+FakeModem::Rule &FakeModem::on(const std::string &prefix) {
+  _rules.push_back(Rule());
+  _rules.back().prefix = prefix;
+  return _rules.back();
+}
+
+void FakeModem::inject(const std::string &text, uint32_t delayMs) {
+  injectRaw(frame(text), delayMs);
+}
+
+void FakeModem::injectRaw(const std::string &bytes, uint32_t delayMs) {
+  schedule(bytes, now() + (uint64_t)delayMs * 1000);
+}
+
+void FakeModem::reset() {
+  _rules.clear();
+  _scheduled.clear();
+  _out.clear();
+  _commands.clear();
+  _line.clear();
+  _payload.clear();
+  _dataRule = nullptr;
+  _dataRemaining = 0;
+  _dataCtrlZ = false;
+  _skipLf = false;
+  _lineFreeUs = 0;
+  _bytesIn = 0;
+  _bytesOut = 0;
+}
+
+std::string FakeModem::unescape(const std::string &text) {
+  std::string out;
+  out.reserve(text.size());
+  for (size_t i = 0; i < text.size(); i++) {
+    char c = text[i];
+    if (c != '\\' || i + 1 >= text.size()) {
+      out += c;
+      continue;
+    }
+    char e = text[++i];
+    switch (e) {
+    case 'r':
+      out += '\r';
+      break;
+    case 'n':
+      out += '\n';
+      break;
+    case 't':
+      out += '\t';
+      break;
+    case '0':
+      out += '\0';
+      break;
+    case 'x':
+      if (i + 2 < text.size() && isxdigit((unsigned char)text[i + 1]) &&
+          isxdigit((unsigned char)text[i + 2])) {
+        out += (char)strtol(text.substr(i + 1, 2).c_str(), nullptr, 16);
+        i += 2;
+      } else {
+        out += 'x';
+      }
+      break;
+    default:
+      out += e;
+      break;
+    }
+  }
+  return out;
+}
+
+bool FakeModem::loadTranscript(const std::string &text) {
+  std::istringstream in(text);
+  std::string line;
+  Rule *rule = nullptr;
+  while (std::getline(in, line)) {
+    if (!line.empty() && line.back() == '\r')
+      line.pop_back();
+    if (line.empty() || line[0] == '#')
+      continue;
+
+    if (line.compare(0, 2, "> ") == 0) {
+      rule = &on(line.substr(2));
+    } else if (line.compare(0, 3, "<< ") == 0 && rule) {
+      rule->raw(unescape(line.substr(3)));
+    } else if (line.compare(0, 2, "< ") == 0 && rule) {
+      rule->line(line.substr(2));
+    } else if (line == "<" && rule) {
+      rule->line("");
+    } else if (line.compare(0, 5, "data ") == 0 && rule) {
+      std::string arg = line.substr(5);
+      if (arg == "ctrlz")
+        rule->dataUntilCtrlZ();
+      else
+        rule->data(atoi(arg.c_str()));
+    } else if (line.compare(0, 4, "urc ") == 0 && rule) {
+      size_t sp = line.find(' ', 4);
+      if (sp == std::string::npos)
+        return false;
+      rule->urc(strtoul(line.c_str() + 4, nullptr, 10), line.substr(sp + 1));
+    } else if (line.compare(0, 6, "times ") == 0 && rule) {
+      rule->times(atoi(line.c_str() + 6));
+    } else if (line.compare(0, 7, "inject ") == 0) {
+      size_t sp = line.find(' ', 7);
+      if (sp == std::string::npos)
+        return false;
+      inject(line.substr(sp + 1), strtoul(line.c_str() + 7, nullptr, 10));
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+void FakeModem::schedule(const std::string &bytes, uint64_t startUs) {
+  Chunk chunk;
+  chunk.startUs = startUs;
+  chunk.bytes = bytes;
+  // Keep the pending list ordered by start time; equal times stay FIFO.
+  auto pos = std::upper_bound(
+      _scheduled.begin(), _scheduled.end(), startUs,
+      [](uint64_t t, const Chunk &c) { return t < c.startUs; });
+  _scheduled.insert(pos, chunk);
+  promote();
+}
+
+void FakeModem::promote() {
+  uint64_t t = now();
+  size_t n = 0;
+  while (n < _scheduled.size() && _scheduled[n].startUs <= t) {
+    const Chunk &chunk = _scheduled[n];
+    uint64_t at = std::max(chunk.startUs, _lineFreeUs);
+    uint64_t step = _baud ? (10000000ULL / _baud) : 0;
+    for (char c : chunk.bytes) {
+      Byte b;
+      b.releaseUs = at;
+      b.value = (uint8_t)c;
+      _out.push_back(b);
+      at += step;
+    }
+    _lineFreeUs = at;
+    n++;
+  }
+  if (n)
+    _scheduled.erase(_scheduled.begin(), _scheduled.begin() + n);
+}
+
+size_t FakeModem::releasedCount() const {
+  uint64_t t = now();
+  if (_out.empty() || _out.back().releaseUs <= t)
+    return _out.size();
+  auto it = std::upper_bound(_out.begin(), _out.end(), t,
+                             [](uint64_t v, const Byte &b) {
+                               return v < b.releaseUs;
+                             });
+  return it - _out.begin();
+}
+
+int FakeModem::available() {
+  promote();
+  return (int)releasedCount();
+}
+
+int FakeModem::read() {
+  if (available() == 0)
+    return -1;
+  uint8_t c = _out.front().value;
+  _out.pop_front();
+  _bytesOut++;
+  return c;
+}
+
+int FakeModem::peek() {
+  if (available() == 0)
+    return -1;
+  return _out.front().value;
+}
+
+size_t FakeModem::write(const uint8_t *buffer, size_t size) {
+  for (size_t i = 0; i < size; i++)
+    write(buffer[i]);
+  return size;
+}
+
+size_t FakeModem::write(uint8_t c) {
+  _bytesIn++;
+
+  // println() terminates commands with CR LF; the LF must not leak into a
+  // payload phase that the CR just opened.
+  bool skipLf = _skipLf;
+  _skipLf = false;
+  if (skipLf && c == '\n')
+    return 1;
+
+  if (_dataRule) {
+    if (_dataCtrlZ) {
+      if (c == 0x1A)
+        finishData();
+      else
+        _payload += (char)c;
+    } else {
+      _payload += (char)c;
+      if (--_dataRemaining == 0)
+        finishData();
+    }
+    return 1;
+  }
+
+  if (c == '\r' || c == '\n') {
+    if (!_line.empty()) {
+      _skipLf = (c == '\r');
+      std::string cmd;
+      cmd.swap(_line);
+      handleCommand(cmd);
+    }
+    return 1;
+  }
+  _line += (char)c;
+  // The transparent-mode escape comes without a line ending
+  if (_line == "+++") {
+    std::string cmd;
+    cmd.swap(_line);
+    handleCommand(cmd);
+  }
+  return 1;
+}
+
+void FakeModem::handleCommand(const std::string &cmd) {
+  _commands.push_back(cmd);
+  uint64_t start = now() + _latencyUs;
+
+  for (Rule &rule : _rules) {
+    if (rule.remaining == 0 || cmd.compare(0, rule.prefix.size(),
+                                           rule.prefix) != 0) {
+      continue;
+    }
+    if (rule.remaining > 0)
+      rule.remaining--;
+
+    schedule(rule.reply, start);
+    if (!rule.ctrlZ && rule.dataArg < 0) {
+      for (const auto &urc : rule.urcs)
+        schedule(urc.second, start + (uint64_t)urc.first * 1000);
+    }
+
+    if (rule.ctrlZ) {
+      _dataRule = &rule;
+      _dataCtrlZ = true;
+    } else if (rule.dataArg >= 0) {
+      // Payload length comes from the command's numeric arguments.
+      size_t eq = cmd.find('=');
+      std::vector<std::string> args;
+      if (eq != std::string::npos) {
+        std::string list = cmd.substr(eq + 1);
+        size_t pos = 0;
+        while (true) {
+          size_t comma = list.find(',', pos);
+          args.push_back(list.substr(pos, comma - pos));
+          if (comma == std::string::npos)
+            break;
+          pos = comma + 1;
+        }
+      }
+      if (rule.dataArg < (int)args.size()) {
+        _dataRemaining = strtoul(args[rule.dataArg].c_str(), nullptr, 10);
+      } else {
+        _dataRemaining = 0;
+      }
+      if (_dataRemaining > 0) {
+        _dataRule = &rule;
+        _dataCtrlZ = false;
+      } else {
+        _dataRule = &rule;
+        finishData();
+      }
+    }
+    return;
+  }
+
+  schedule(_defaultReply, start);
+}
+
+void FakeModem::finishData() {
+  Rule *rule = _dataRule;
+  _dataRule = nullptr;
+  _dataCtrlZ = false;
+  _dataRemaining = 0;
+  // URCs of payload-carrying commands are relative to the payload's end.
+  uint64_t start = now() + _latencyUs;
+  schedule(rule->afterData, start);
+  for (const auto &urc : rule->urcs)
+    schedule(urc.second, start + (uint64_t)urc.first * 1000);
+}
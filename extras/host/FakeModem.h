@@ -0,0 +1,141 @@
+/*
+  FakeModem - scriptable EC200U simulator for host builds.
+
+  A Stream that plays the modem side of the UART. Commands written by the
+  library are matched against rules (by prefix); each rule replies with a
+  byte string, can swallow a payload phase (QHTTPURL, QHTTPPOST, QISEND,
+  QFUPL, CMGS ...) and can schedule URCs some milliseconds later. Replies are
+  released at the configured baud rate so timing-sensitive code (polling
+  delays, terminator detection, chunked reads) behaves like it does on a real
+  UART.
+
+  Rules can be built in code:
+
+    modem.on("AT+CSQ").line("+CSQ: 20,99").ok();
+    modem.on("AT+QHTTPURL=").raw("\r\nCONNECT\r\n").data(0).line("OK");
+    modem.on("AT+QHTTPGET=").ok().urc(50, "+QHTTPGET: 0,200,12");
+    modem.on("+++").ok();     // transparent-mode escape, no line ending
+
+  or loaded from a transcript:
+
+    # comment
+    > AT+CSQ                  start a rule matching this command prefix
+    < +CSQ: 20,99             reply line, framed as "\r\n<line>\r\n"
+    << \r\nCONNECT\r\n        raw reply bytes (\r \n \t \\ \xHH escapes)
+    data 0                    payload length is numeric argument 0
+    data ctrlz                payload runs until Ctrl-Z (0x1A)
+    < OK                      lines after "data" are sent once it is consumed
+    urc 50 +QHTTPGET: 0,200   framed URC 50 ms after the reply
+    times 1                   rule only matches once
+    inject 200 RING           unsolicited line 200 ms after loading
+*/
+
+#ifndef QUECTEL_FAKE_MODEM_H
+#define QUECTEL_FAKE_MODEM_H
+
+#include <Arduino.h>
+
+#include <deque>
+#include <string>
+#include <vector>
+
+class FakeModem : public Stream {
+public:
+  struct Rule {
+    std::string prefix;
+    std::string reply;
+    std::string afterData;
+    std::vector<std::pair<uint32_t, std::string>> urcs;
+    int dataArg = -1;
+    bool ctrlZ = false;
+    int remaining = -1;
+
+    // Append a framed line ("\r\n<text>\r\n") to the reply, or to the
+    // post-payload reply once data() has been called.
+    Rule &line(const std::string &text);
+    // Append raw bytes to the reply (or post-payload reply).
+    Rule &raw(const std::string &bytes);
+    Rule &ok() { return line("OK"); }
+    Rule &error() { return line("ERROR"); }
+    // Expect a payload whose length is numeric argument `argIndex`.
+    Rule &data(int argIndex);
+    // Expect a payload terminated by Ctrl-Z.
+    Rule &dataUntilCtrlZ();
+    // Schedule a framed URC `delayMs` after the reply.
+    Rule &urc(uint32_t delayMs, const std::string &text);
+    Rule &times(int n);
+  };
+
+  explicit FakeModem(uint32_t baud = 0);
+
+  // 0 releases every reply byte immediately; otherwise bytes are paced at
+  // 10 bits per byte.
+  void setBaud(uint32_t baud) { _baud = baud; }
+  // Modem processing time between a command and the first reply byte.
+  void setLatency(uint32_t micros) { _latencyUs = micros; }
+  // Reply for commands no rule matches (default "\r\nERROR\r\n").
+  void setDefaultReply(const std::string &reply) { _defaultReply = reply; }
+
+  Rule &on(const std::string &prefix);
+  void inject(const std::string &text, uint32_t delayMs = 0);
+  void injectRaw(const std::string &bytes, uint32_t delayMs = 0);
+  bool loadTranscript(const std::string &text);
+  void reset();
+
+  static std::string unescape(const std::string &text);
+  static std::string frame(const std::string &line) {
+    return "\r\n" + line + "\r\n";
+  }
+
+  const std::vector<std::string> &commands() const { return _commands; }
+  const std::string &payload() const { return _payload; }
+  size_t bytesReceived() const { return _bytesIn; }
+  size_t bytesSent() const { return _bytesOut; }
+  size_t pending() const { return _out.size(); }
+
+  // Stream
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t *buffer, size_t size) override;
+  using Print::write;
+  int availableForWrite() override { return 4096; }
+
+private:
+  struct Byte {
+    uint64_t releaseUs;
+    uint8_t value;
+  };
+
+  struct Chunk {
+    uint64_t startUs;
+    std::string bytes;
+  };
+
+  std::deque<Rule> _rules;
+  std::vector<Chunk> _scheduled;
+  std::deque<Byte> _out;
+  std::vector<std::string> _commands;
+  std::string _line;
+  std::string _payload;
+  std::string _defaultReply;
+  Rule *_dataRule;
+  size_t _dataRemaining;
+  bool _dataCtrlZ;
+  bool _skipLf;
+  uint32_t _baud;
+  uint32_t _latencyUs;
+  uint64_t _lineFreeUs;
+  size_t _bytesIn;
+  size_t _bytesOut;
+
+  uint64_t now() const { return micros(); }
+  void schedule(const std::string &bytes, uint64_t startUs);
+  void promote();
+  void handleCommand(const std::string &cmd);
+  void finishData();
+  size_t releasedCount() const;
+};
+
+#endif
@@ -0,0 +1,32 @@
+/*
+  QuectelHostProbe - host-only access to QuectelEC200U internals.
+
+  Benchmarks use this to time private helpers (response collectors and
+  parsers) in isolation. Never include it from firmware.
+*/
+
+#ifndef QUECTEL_HOST_PROBE_H
+#define QUECTEL_HOST_PROBE_H
+
+#include <QuectelEC200U.h>
+
+class QuectelHostProbe {
+public:
+  static String collectResponse(QuectelEC200U &modem, uint32_t timeout) {
+    return modem._collectResponse(timeout);
+  }
+  static int parseCsvInt(QuectelEC200U &modem, const String &response,
+                         const String &tag, int index) {
+    return modem._parseCsvInt(response, tag, index);
+  }
+  static String parseCsvString(QuectelEC200U &modem, const String &response,
+                               const String &tag, int index) {
+    return modem._parseCsvString(response, tag, index);
+  }
+  static bool extractHttpPayload(QuectelEC200U &modem, const String &raw,
+                                 String &payload) {
+    return modem._extractHttpPayload(raw, payload);
+  }
+};
+
+#endif
@@ -0,0 +1,17 @@
+/*
+  Host-side Arduino HardwareSerial. There is no UART on the host; the class
+  only exists so the library's HardwareSerial members compile.
+*/
+
+#ifndef QUECTEL_HOST_HARDWARESERIAL_H
+#define QUECTEL_HOST_HARDWARESERIAL_H
+
+#include "Stream.h"
+
+class HardwareSerial : public Stream {
+public:
+  virtual void begin(unsigned long baud) { (void)baud; }
+  virtual void end() {}
+};
+
+#endif
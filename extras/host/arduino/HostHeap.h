@@ -0,0 +1,28 @@
+/*
+  Heap accounting for the host build.
+
+  The String shim reports every buffer (re)allocation and every byte it copies
+  here, which lets benchmarks attribute heap churn to individual library
+  calls.
+*/
+
+#ifndef QUECTEL_HOST_HEAP_H
+#define QUECTEL_HOST_HEAP_H
+
+struct HostHeapStats {
+  unsigned long allocations;    // malloc + realloc calls
+  unsigned long frees;          // free calls
+  unsigned long bytesAllocated; // sum of requested block sizes
+  unsigned long bytesCopied;    // bytes moved between String buffers
+};
+
+extern HostHeapStats hostHeapStats;
+
+inline void hostHeapReset() {
+  hostHeapStats.allocations = 0;
+  hostHeapStats.frees = 0;
+  hostHeapStats.bytesAllocated = 0;
+  hostHeapStats.bytesCopied = 0;
+}
+
+#endif
@@ -0,0 +1,27 @@
+/*
+  Host-side Arduino IPAddress (IPv4 only).
+*/
+
+#ifndef QUECTEL_HOST_IPADDRESS_H
+#define QUECTEL_HOST_IPADDRESS_H
+
+#include <stdint.h>
+
+class IPAddress {
+public:
+  IPAddress() : IPAddress(0, 0, 0, 0) {}
+  IPAddress(uint8_t a, uint8_t b, uint8_t c, uint8_t d) {
+    _bytes[0] = a;
+    _bytes[1] = b;
+    _bytes[2] = c;
+    _bytes[3] = d;
+  }
+  uint8_t operator[](int index) const { return _bytes[index]; }
+  uint8_t &operator[](int index) { return _bytes[index]; }
+  uint8_t *raw_address() { return _bytes; }
+
+private:
+  uint8_t _bytes[4];
+};
+
+#endif
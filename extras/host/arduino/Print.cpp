@@ -0,0 +1,144 @@
+/*
+  Host-side Arduino Print implementation.
+*/
+
+#include "Arduino.h"
+
+#include <stdarg.h>
+
+size_t Print::write(const uint8_t *buffer, size_t size) {
+  size_t n = 0;
+  while (size--) {
+    if (write(*buffer++))
+      n++;
+    else
+      break;
+  }
+  return n;
+}
+
+size_t Print::print(const __FlashStringHelper *ifsh) {
+  return write(reinterpret_cast<const char *>(ifsh));
+}
+
+size_t Print::print(const String &s) { return write(s.c_str(), s.length()); }
+
+size_t Print::print(const char str[]) { return write(str); }
+
+size_t Print::print(char c) { return write((uint8_t)c); }
+
+size_t Print::print(unsigned char b, int base) {
+  return print((unsigned long)b, base);
+}
+
+size_t Print::print(int n, int base) { return print((long)n, base); }
+
+size_t Print::print(unsigned int n, int base) {
+  return print((unsigned long)n, base);
+}
+
+size_t Print::print(long n, int base) {
+  if (base == 10 && n < 0)
+    return printNumber((unsigned long)(-n), 10, true);
+  return printNumber((unsigned long)n, base, false);
+}
+
+size_t Print::print(unsigned long n, int base) {
+  return printNumber(n, base, false);
+}
+
+size_t Print::print(double n, int digits) {
+  char buf[64];
+  int len = snprintf(buf, sizeof(buf), "%.*f", digits, n);
+  return write(buf, len > 0 ? (size_t)len : 0);
+}
+
+size_t Print::println(const __FlashStringHelper *ifsh) {
+  size_t n = print(ifsh);
+  return n + println();
+}
+
+size_t Print::println(const String &s) {
+  size_t n = print(s);
+  return n + println();
+}
+
+size_t Print::println(const char c[]) {
+  size_t n = print(c);
+  return n + println();
+}
+
+size_t Print::println(char c) {
+  size_t n = print(c);
+  return n + println();
+}
+
+size_t Print::println(unsigned char b, int base) {
+  size_t n = print(b, base);
+  return n + println();
+}
+
+size_t Print::println(int num, int base) {
+  size_t n = print(num, base);
+  return n + println();
+}
+
+size_t Print::println(unsigned int num, int base) {
+  size_t n = print(num, base);
+  return n + println();
+}
+
+size_t Print::println(long num, int base) {
+  size_t n = print(num, base);
+  return n + println();
+}
+
+size_t Print::println(unsigned long num, int base) {
+  size_t n = print(num, base);
+  return n + println();
+}
+
+size_t Print::println(double num, int digits) {
+  size_t n = print(num, digits);
+  return n + println();
+}
+
+size_t Print::println() { return write("\r\n"); }
+
+size_t Print::printf(const char *format, ...) {
+  char buf[256];
+  va_list args;
+  va_start(args, format);
+  int len = vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+  if (len < 0)
+    return 0;
+  if ((size_t)len < sizeof(buf))
+    return write(buf, len);
+
+  char *big = (char *)malloc(len + 1);
+  if (!big)
+    return 0;
+  va_start(args, format);
+  vsnprintf(big, len + 1, format, args);
+  va_end(args);
+  size_t n = write(big, len);
+  free(big);
+  return n;
+}
+
+size_t Print::printNumber(unsigned long n, int base, bool negative) {
+  char buf[8 * sizeof(long) + 2];
+  char *str = &buf[sizeof(buf) - 1];
+  *str = '\0';
+  if (base < 2)
+    base = 10;
+  do {
+    char c = n % base;
+    n /= base;
+    *--str = c < 10 ? c + '0' : c + 'A' - 10;
+  } while (n);
+  if (negative)
+    *--str = '-';
+  return write(str);
+}
@@ -0,0 +1,28 @@
+/*
+  Host-side SoftwareSerial placeholder. The library header pulls this in on
+  boards without a HardwareSerial; on the host every modem is a Stream.
+*/
+
+#ifndef QUECTEL_HOST_SOFTWARESERIAL_H
+#define QUECTEL_HOST_SOFTWARESERIAL_H
+
+#include "Arduino.h"
+
+class SoftwareSerial : public Stream {
+public:
+  SoftwareSerial(uint8_t rx, uint8_t tx) {
+    (void)rx;
+    (void)tx;
+  }
+  void begin(long baud) { (void)baud; }
+  int available() override { return 0; }
+  int read() override { return -1; }
+  int peek() override { return -1; }
+  size_t write(uint8_t c) override {
+    (void)c;
+    return 1;
+  }
+  using Print::write;
+};
+
+#endif
@@ -0,0 +1,20 @@
+/*
+  Benchmark harness support: result printing.
+*/
+
+#include "Bench.h"
+
+#include <stdio.h>
+
+void benchPrintHeader(const char *title) {
+  printf("\n== %s\n", title);
+  printf("%-34s %8s %8s %12s %10s %12s %12s\n", "case", "bytes", "iters",
+         "us/call", "allocs", "heap B", "copied B");
+}
+
+void benchPrint(const BenchResult &r) {
+  printf("%-34s %8zu %8lu %12.2f %10.1f %12.0f %12.0f\n", r.name.c_str(),
+         r.size, r.iterations, r.usPerCall, r.allocsPerCall,
+         r.heapBytesPerCall, r.copiedPerCall);
+  fflush(stdout);
+}
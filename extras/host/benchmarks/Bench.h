@@ -0,0 +1,67 @@
+/*
+  Minimal benchmark harness for the host build.
+
+  bench() calls a function repeatedly until both a minimum iteration count
+  and a minimum wall time are reached, and reports per-call wall time plus
+  the heap activity recorded by the String shim (HostHeap.h). String is the
+  only allocator the library uses, so those counters cover all of its heap
+  traffic while leaving out the simulator's own bookkeeping.
+*/
+
+#ifndef QUECTEL_HOST_BENCH_H
+#define QUECTEL_HOST_BENCH_H
+
+#include <Arduino.h>
+
+#include <chrono>
+#include <string>
+
+struct BenchResult {
+  std::string name;
+  size_t size;
+  unsigned long iterations;
+  double usPerCall;
+  double allocsPerCall;
+  double heapBytesPerCall;
+  double copiedPerCall;
+};
+
+void benchPrintHeader(const char *title);
+void benchPrint(const BenchResult &result);
+
+// `setup` runs before every call and is excluded from timing and heap
+// accounting (used to queue the simulated modem's reply).
+template <typename Setup, typename Fn>
+BenchResult bench(const std::string &name, size_t size, Setup setup, Fn fn,
+                  unsigned long minIterations = 20, double minSeconds = 0.2) {
+  typedef std::chrono::steady_clock Clock;
+  BenchResult r;
+  r.name = name;
+  r.size = size;
+  r.iterations = 0;
+  double totalUs = 0;
+  unsigned long allocs = 0, heapBytes = 0, copied = 0;
+
+  while (r.iterations < minIterations || totalUs < minSeconds * 1e6) {
+    setup();
+    hostHeapReset();
+    Clock::time_point t0 = Clock::now();
+    fn();
+    Clock::time_point t1 = Clock::now();
+    totalUs += std::chrono::duration<double, std::micro>(t1 - t0).count();
+    allocs += hostHeapStats.allocations;
+    heapBytes += hostHeapStats.bytesAllocated;
+    copied += hostHeapStats.bytesCopied;
+    r.iterations++;
+    if (r.iterations >= 100000)
+      break;
+  }
+
+  r.usPerCall = totalUs / r.iterations;
+  r.allocsPerCall = (double)allocs / r.iterations;
+  r.heapBytesPerCall = (double)heapBytes / r.iterations;
+  r.copiedPerCall = (double)copied / r.iterations;
+  return r;
+}
+
+#endif
@@ -0,0 +1,78 @@
+/*
+  AT command builder benchmark.
+
+  Compares assembling a command by String concatenation (the way the
+  library used to build them) with formatting it into an ATCommand stack
+  buffer, then runs a few library calls end to end against the simulated
+  modem:
+
+    String chain        "AT+QIOPEN=" + String(ctxId) + "," + ...
+    ATCommand           ATCommand("AT+QIOPEN=%d,%d,...", ...)
+    activatePDP         AT+QIACT=<ctx> round trip
+    configureContext    AT+QICSGP with APN and credentials
+    tcpOpen             AT+QIOPEN plus the +QIOPEN URC
+
+  Every row is expected to report 0 allocations per call except the String
+  chain.
+
+  usage: bench_at_command
+*/
+
+#include <QuectelEC200U.h>
+
+#include "Bench.h"
+#include "FakeModem.h"
+
+#include <stdio.h>
+
+static size_t sink;
+
+int main() {
+  FakeModem sim(0);
+  QuectelEC200U modem(sim);
+  modem.setReadWaitMode(ReadWaitMode::SPIN_YIELD);
+
+  const char *host = "api.thingspeak.com";
+  int ctxId = 1, socketId = 3, port = 443;
+
+  benchPrintHeader("command formatting");
+  benchPrint(bench(
+      "String chain", 0, [] {},
+      [&] {
+        String cmd = "AT+QIOPEN=" + String(ctxId) + "," + String(socketId) +
+                     ",\"TCP\",\"" + host + "\"," + String(port) + ",0,1";
+        sink += cmd.length();
+      }));
+  benchPrint(bench(
+      "ATCommand", 0, [] {},
+      [&] {
+        ATCommand cmd("AT+QIOPEN=%d,%d,\"TCP\",\"%s\",%d,0,1", ctxId,
+                      socketId, host, port);
+        sink += cmd.length();
+      }));
+
+  benchPrintHeader("library calls, unpaced modem");
+  benchPrint(bench(
+      "activatePDP", 0,
+      [&] {
+        sim.reset();
+        sim.on("AT+QIACT=1").ok();
+      },
+      [&] { modem.activatePDP(1); }));
+  benchPrint(bench(
+      "configureContext", 0,
+      [&] {
+        sim.reset();
+        sim.on("AT+QICSGP=1,1,").ok();
+      },
+      [&] { modem.configureContext(1, 1, "jionet", "user", "secret", 1); }));
+  benchPrint(bench(
+      "tcpOpen", 0,
+      [&] {
+        sim.reset();
+        sim.on("AT+QIOPEN=1,3,").ok().urc(0, "+QIOPEN: 3,0");
+      },
+      [&] { modem.tcpOpen(host, port, ctxId, socketId); }));
+
+  return sink == 0;
+}
@@ -0,0 +1,258 @@
+/*
+  AT round-trip and parser benchmark.
+
+  Measures the library's response paths against the simulated modem for
+  response sizes from a single line up to 64 KB:
+
+    sendAT              command + read into the fixed internal buffer
+    readResponse(buf)   command + read into a caller buffer
+    readResponse(Print) command + stream through a chunk callback sink
+    _collectResponse    command + read into a growing String
+    _parseCsvInt        tag lookup + integer field
+    extractQuotedString tag lookup + quoted field
+    ATTokenizer         tag lookup + all 11 fields of a +QGPSLOC line
+    _extractHttpPayload body extraction from a QHTTPREAD transcript
+    httpGet(String)     full GET, body collected into a String
+    httpGet(Print&)     full GET, body streamed through a chunk callback
+    httpGet(Response)   full GET into HttpResponse, reserved from the URC
+    httpPost(String)    full POST, body assembled in a String first
+    httpPost(writer)    full POST, body generated straight onto the UART
+
+  The first table runs with an unpaced modem (pure CPU/parse cost). The
+  others pace replies at 115200 baud to show end-to-end latency for each
+  ReadWaitMode, including time spent sleeping between polls.
+
+  usage: bench_at_roundtrip [max_bytes]
+*/
+
+#include <QuectelEC200U.h>
+
+#include "Bench.h"
+#include "FakeModem.h"
+#include "QuectelHostProbe.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+static std::string listing(size_t size) {
+  std::string out;
+  char line[64];
+  int n = 0;
+  while (out.size() < size) {
+    snprintf(line, sizeof(line), "\r\n+QFLST: \"UFS:log_%05d.txt\",%d\r\n", n,
+             1000 + n);
+    out += line;
+    n++;
+  }
+  return out;
+}
+
+static std::string httpBody(size_t size) {
+  std::string out = "{\"feeds\":[";
+  while (out.size() + 32 < size)
+    out += "{\"t\":1718000000,\"v\":23.5},";
+  out += "{\"t\":0}]}";
+  return out;
+}
+
+static void drain(FakeModem &sim) {
+  while (sim.available())
+    sim.read();
+}
+
+static void countChunk(const uint8_t *, size_t len, void *arg) {
+  *static_cast<size_t *>(arg) += len;
+}
+
+// Generates a POST body on the fly, as a sensor logger would
+static size_t writeBody(Print &out, size_t length, void *) {
+  uint8_t chunk[64];
+  size_t total = 0;
+  while (total < length) {
+    size_t n = length - total < sizeof(chunk) ? length - total : sizeof(chunk);
+    for (size_t i = 0; i < n; i++)
+      chunk[i] = 'a' + (total + i) % 26;
+    total += out.write(chunk, n);
+  }
+  return total;
+}
+
+static void runSuite(uint32_t baud, ReadWaitMode mode,
+                     const std::vector<size_t> &sizes,
+                     unsigned long minIterations, double minSeconds) {
+  FakeModem sim(baud);
+  QuectelEC200U modem(sim);
+  modem.setReadWaitMode(mode);
+  static char buffer[70000];
+  size_t counted = 0;
+
+  for (size_t size : sizes) {
+    std::string reply = size ? listing(size) : FakeModem::frame("+CSQ: 23,99");
+    reply += FakeModem::frame("OK");
+    size_t bytes = reply.size();
+    sim.reset();
+    sim.on("AT+BENCH").raw(reply);
+
+    benchPrint(bench(
+        "sendAT", bytes, [&] { drain(sim); },
+        [&] { modem.sendAT("AT+BENCH"); }, minIterations, minSeconds));
+
+    benchPrint(bench(
+        "readResponse(char*)", bytes, [&] { drain(sim); },
+        [&] {
+          modem.sendATRaw("AT+BENCH");
+          modem.readResponse(buffer, sizeof(buffer), 5000);
+        },
+        minIterations, minSeconds));
+
+    benchPrint(bench(
+        "readResponse(Print&)", bytes, [&] { drain(sim); },
+        [&] {
+          QuectelChunkSink sink(countChunk, &counted);
+          modem.sendATRaw("AT+BENCH");
+          modem.readResponse(sink, 5000);
+          sink.flush();
+        },
+        minIterations, minSeconds));
+
+    benchPrint(bench(
+        "_collectResponse", bytes, [&] { drain(sim); },
+        [&] {
+          modem.sendATRaw("AT+BENCH");
+          QuectelHostProbe::collectResponse(modem, 5000);
+        },
+        minIterations, minSeconds));
+  }
+
+  if (baud != 0)
+    return;
+
+  for (size_t size : sizes) {
+    String csq((listing(size) + FakeModem::frame("+CSQ: 23,99") +
+                FakeModem::frame("OK"))
+                   .c_str());
+    String tag("+CSQ: ");
+    benchPrint(bench(
+        "_parseCsvInt", csq.length(), [] {},
+        [&] { QuectelHostProbe::parseCsvInt(modem, csq, tag, 1); },
+        minIterations, minSeconds));
+
+    std::string cops = listing(size) +
+                       FakeModem::frame("+COPS: 0,0,\"Jio 4G\",7") +
+                       FakeModem::frame("OK");
+    benchPrint(bench(
+        "extractQuotedString", cops.size(), [] {},
+        [&] { modem.extractQuotedString(cops.c_str(), "+COPS:"); },
+        minIterations, minSeconds));
+
+    std::string loc =
+        listing(size) +
+        FakeModem::frame("+QGPSLOC: 061951.000,3150.7223N,11711.9293E,0.7,"
+                         "62.2,2,0.00,0.0,0.0,110513,09") +
+        FakeModem::frame("OK");
+    benchPrint(bench(
+        "ATTokenizer", loc.size(), [] {},
+        [&] {
+          ATTokenizer tokens(loc.c_str(), "+QGPSLOC: ");
+          ATField field;
+          while (tokens.next(field))
+            counted += field.len;
+        },
+        minIterations, minSeconds));
+
+    String raw(("\r\nCONNECT\r\n" + httpBody(size ? size : 16) +
+                "\r\nOK\r\n\r\n+QHTTPREAD: 0\r\n")
+                   .c_str());
+    benchPrint(bench(
+        "_extractHttpPayload", raw.length(), [] {},
+        [&] {
+          String payload;
+          QuectelHostProbe::extractHttpPayload(modem, raw, payload);
+        },
+        minIterations, minSeconds));
+
+    std::string body = httpBody(size ? size : 16);
+    auto queueGet = [&] {
+      sim.reset();
+      sim.on("AT+QHTTPCFG").ok().times(3);
+      sim.on("AT+QHTTPURL=").raw("\r\nCONNECT\r\n").data(0).ok();
+      sim.on("AT+QHTTPGET=")
+          .ok()
+          .urc(0, "+QHTTPGET: 0,200," + std::to_string(body.size()));
+      sim.on("AT+QHTTPREAD=").raw("\r\nCONNECT\r\n" + body +
+                                  "\r\nOK\r\n\r\n+QHTTPREAD: 0\r\n");
+    };
+    benchPrint(bench(
+        "httpGet(String)", body.size(), queueGet,
+        [&] {
+          String payload;
+          modem.httpGet("http://example.com/feed", payload);
+        },
+        minIterations, minSeconds));
+    benchPrint(bench(
+        "httpGet(Print&)", body.size(), queueGet,
+        [&] { modem.httpGet("http://example.com/feed", countChunk, &counted); },
+        minIterations, minSeconds));
+    benchPrint(bench(
+        "httpGet(Response)", body.size(), queueGet,
+        [&] {
+          QuectelEC200U::HttpResponse response;
+          modem.httpGet("http://example.com/feed", response);
+        },
+        minIterations, minSeconds));
+
+    size_t upload = size ? size : 16;
+    auto queuePost = [&] {
+      sim.reset();
+      sim.on("AT+QHTTPCFG").ok().times(3);
+      sim.on("AT+QHTTPURL=").raw("\r\nCONNECT\r\n").data(0).ok();
+      sim.on("AT+QHTTPPOST=")
+          .raw("\r\nCONNECT\r\n")
+          .data(0)
+          .ok()
+          .urc(0, "+QHTTPPOST: 0,200,2");
+      sim.on("AT+QHTTPREAD=")
+          .raw("\r\nCONNECT\r\nok\r\nOK\r\n\r\n+QHTTPREAD: 0\r\n");
+    };
+    benchPrint(bench(
+        "httpPost(String)", upload, queuePost,
+        [&] {
+          String data;
+          data.reserve(upload);
+          for (size_t i = 0; i < upload; i++)
+            data += (char)('a' + i % 26);
+          String response;
+          modem.httpPost("http://example.com/feed", data.c_str(), response);
+        },
+        minIterations, minSeconds));
+    benchPrint(bench(
+        "httpPost(writer)", upload, queuePost,
+        [&] {
+          String response;
+          modem.httpPost("http://example.com/feed", writeBody, nullptr, upload,
+                         response);
+        },
+        minIterations, minSeconds));
+  }
+}
+
+int main(int argc, char **argv) {
+  size_t maxBytes = argc > 1 ? strtoul(argv[1], nullptr, 10) : 65536;
+  std::vector<size_t> sizes;
+  sizes.push_back(0);
+  for (size_t s = 256; s <= maxBytes; s *= 4)
+    sizes.push_back(s);
+
+  benchPrintHeader("unpaced modem: CPU cost per call");
+  runSuite(0, ReadWaitMode::SPIN_YIELD, sizes, 20, 0.2);
+
+  std::vector<size_t> paced;
+  paced.push_back(0);
+  paced.push_back(1024);
+  benchPrintHeader("115200 baud, POLL_DELAY (10 ms): latency per call");
+  runSuite(115200, ReadWaitMode::POLL_DELAY, paced, 10, 0.1);
+  benchPrintHeader("115200 baud, SPIN_YIELD: latency per call");
+  runSuite(115200, ReadWaitMode::SPIN_YIELD, paced, 10, 0.1);
+  return 0;
+}
@@ -0,0 +1,92 @@
+/*
+  Conditional GET benchmark.
+
+  Polls a 4 KB configuration document that does not change, against the
+  simulated modem at 115200 baud. The simulated server answers the first
+  request with 200 and an ETag, and every request that carries the
+  validator with 304. Reports wall time and bytes per poll:
+
+    httpsGet            full download on every poll
+    QuectelHttpCache    If-None-Match, 304 answered from the RAM cache
+
+  "body B" is what the server sends over the cellular link; "UART B" is
+  what the modem sends to the MCU.
+
+  usage: bench_http_cache [polls]
+*/
+
+#include <QuectelEC200U.h>
+#include <QuectelHttpCache.h>
+
+#include "Bench.h"
+#include "FakeModem.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+static const char *URL = "https://config.example.com/device/42.json";
+static const size_t SIZE = 4096;
+
+static std::string document() {
+  std::string body = "{\"config\":\"";
+  while (body.size() < SIZE - 2)
+    body += (char)('a' + body.size() % 26);
+  return body + "\"}";
+}
+
+static void queueReplies(FakeModem &sim, const std::string &body,
+                         bool conditional) {
+  std::string length = std::to_string(body.size());
+  std::string headers = "HTTP/1.1 200 OK\r\nETag: W/\"v1\"\r\n"
+                        "Content-Length: " + length + "\r\n\r\n";
+  sim.reset();
+  sim.on("AT+QHTTPCFG").ok();
+  sim.on("AT+QHTTPURL=").raw("\r\nCONNECT\r\n").data(0).ok();
+  if (conditional) {
+    sim.on("AT+QHTTPGET=").ok().urc(0, "+QHTTPGET: 0,200," + length).times(1);
+    sim.on("AT+QHTTPREAD=")
+        .raw("\r\nCONNECT\r\n" + headers + body +
+             "\r\nOK\r\n\r\n+QHTTPREAD: 0\r\n")
+        .times(1);
+    sim.on("AT+QHTTPGET=").ok().urc(0, "+QHTTPGET: 0,304,0");
+    sim.on("AT+QHTTPREAD=")
+        .raw("\r\nCONNECT\r\nHTTP/1.1 304 Not Modified\r\nETag: W/\"v1\"\r\n"
+             "\r\n\r\nOK\r\n\r\n+QHTTPREAD: 0\r\n");
+  } else {
+    sim.on("AT+QHTTPGET=").ok().urc(0, "+QHTTPGET: 0,200," + length);
+    sim.on("AT+QHTTPREAD=")
+        .raw("\r\nCONNECT\r\n" + body + "\r\nOK\r\n\r\n+QHTTPREAD: 0\r\n");
+  }
+}
+
+int main(int argc, char **argv) {
+  unsigned long polls = argc > 1 ? strtoul(argv[1], nullptr, 10) : 20;
+  std::string body = document();
+  FakeModem sim(115200);
+  QuectelEC200U modem(sim);
+  modem.setReadWaitMode(ReadWaitMode::SPIN_YIELD);
+  QuectelHttpCache cache(modem);
+  String out;
+
+  benchPrintHeader("4 KB config poll, 115200 baud");
+
+  queueReplies(sim, body, false);
+  BenchResult plain = bench(
+      "httpsGet", body.size(), [] {}, [&] { modem.httpsGet(URL, out); },
+      polls, 0);
+  benchPrint(plain);
+  printf("  body B/poll %zu, UART B/poll %zu\n", body.size(),
+         sim.bytesSent() / plain.iterations);
+
+  queueReplies(sim, body, true);
+  BenchResult cached = bench(
+      "QuectelHttpCache", body.size(), [] {}, [&] { cache.get(URL, out); },
+      polls, 0);
+  benchPrint(cached);
+  printf("  body B/poll %zu, UART B/poll %zu, %lu hits / %lu misses\n",
+         body.size() * cache.misses() / cached.iterations,
+         sim.bytesSent() / cached.iterations, (unsigned long)cache.hits(),
+         (unsigned long)cache.misses());
+  return out.length() != body.size();
+}
@@ -0,0 +1,180 @@
+/*
+  HTTP compression benchmark.
+
+  Posts a JSON telemetry batch and fetches a JSON document against the
+  simulated modem at 115200 baud, with setHttpCompression() off and on.
+  The simulated server answers the compressed GET with a gzip body made by
+  QuectelDeflater, and then with one made by `gzip -9`, whose dynamic
+  Huffman blocks QuectelDeflater never emits. Every GET checks the decoded
+  bytes against the document. Reports wall time and bytes per request:
+
+    httpPost            body sent as is / gzipped (Content-Encoding: gzip)
+    httpGet             body received as is / gzipped and inflated
+    httpGet gzip -9     the same document from the gzip -9 fixture
+
+  "body B" is what crosses the cellular link (what a metered SIM bills);
+  "UART B" is everything the modem sends to the MCU, response headers
+  included. The inflater window comes from malloc() and is not part of
+  the heap columns.
+
+  usage: bench_http_gzip [requests]
+*/
+
+#include <QuectelEC200U.h>
+#include <QuectelGzip.h>
+
+#include "Bench.h"
+#include "FakeModem.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+static const char *URL = "http://telemetry.example.com/v1/batch";
+
+class StdStringPrint : public Print {
+public:
+  std::string data;
+  size_t write(uint8_t c) override {
+    data += (char)c;
+    return 1;
+  }
+  size_t write(const uint8_t *buf, size_t len) override {
+    data.append((const char *)buf, len);
+    return len;
+  }
+  using Print::write;
+};
+
+static std::string telemetry() {
+  std::string json = "{\"device\":\"ec200u-0042\",\"samples\":[";
+  for (int i = 0; i < 24; i++) {
+    if (i > 0)
+      json += ",";
+    json += "{\"ts\":" + std::to_string(1760000000 + i * 60) +
+            ",\"temperature\":" + std::to_string(21 + i % 4) + "." +
+            std::to_string(i % 10) + ",\"humidity\":" +
+            std::to_string(40 + i % 7) + ",\"battery\":" +
+            std::to_string(3900 - i) + ",\"status\":\"ok\"}";
+  }
+  return json + "]}";
+}
+
+// `gzip -9 -n` of the GET document built in main() (telemetry() repeated
+// to 4 KB); one final dynamic Huffman block. Regenerate it if telemetry()
+// changes.
+static const uint8_t GZIP9_DOCUMENT[] = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xed, 0x95,
+    0x4d, 0x4e, 0xc3, 0x30, 0x10, 0x85, 0xef, 0xe2, 0x75, 0x88, 0xfc, 0x17,
+    0x7b, 0xdc, 0xab, 0x20, 0x16, 0xa1, 0xb5, 0x44, 0x05, 0x15, 0x55, 0xeb,
+    0x20, 0xa1, 0xaa, 0x77, 0xc7, 0x88, 0x0d, 0xd3, 0x0e, 0x2f, 0x1c, 0x60,
+    0xb2, 0x89, 0x12, 0x39, 0xdf, 0xe2, 0xe9, 0xbd, 0x7c, 0x17, 0xb3, 0xab,
+    0x1f, 0xfb, 0x6d, 0x35, 0x1b, 0x53, 0xb7, 0xde, 0xda, 0xe5, 0xc1, 0xda,
+    0xe8, 0xcd, 0x60, 0xce, 0xf3, 0xe1, 0xf8, 0x56, 0xcf, 0x66, 0xf3, 0x78,
+    0x31, 0xad, 0xdf, 0x5c, 0x4e, 0xf6, 0xe7, 0x1a, 0x4c, 0xab, 0x87, 0x63,
+    0x3d, 0xcd, 0x6d, 0x39, 0xf5, 0xef, 0xbc, 0x1b, 0xfb, 0xab, 0x97, 0xe5,
+    0xb0, 0xdf, 0xed, 0xdb, 0xa7, 0xd9, 0xc4, 0xfe, 0xf4, 0x3c, 0xb7, 0x56,
+    0x4f, 0xfd, 0x21, 0x94, 0xef, 0xf3, 0xe7, 0xd6, 0xcf, 0x76, 0x86, 0x79,
+    0x7f, 0x35, 0xd7, 0x81, 0xf3, 0xd2, 0x1d, 0xcf, 0x8f, 0x8e, 0xf1, 0xdc,
+    0x6f, 0x1e, 0x95, 0x02, 0x79, 0xce, 0xdf, 0xf1, 0xc2, 0xe8, 0x19, 0xcf,
+    0x73, 0x1e, 0x61, 0x1e, 0xdd, 0xf1, 0xe2, 0x18, 0x18, 0x2f, 0x70, 0x5e,
+    0x86, 0x3c, 0x1f, 0x85, 0xfc, 0x22, 0xe3, 0x45, 0xce, 0x4b, 0x90, 0x17,
+    0xac, 0x90, 0xdf, 0xc4, 0x78, 0x13, 0xe7, 0x4d, 0x98, 0x97, 0x84, 0xfc,
+    0x12, 0xe3, 0x25, 0xce, 0x8b, 0x90, 0x17, 0xbd, 0x90, 0x5f, 0xfe, 0xbb,
+    0x2f, 0x54, 0x02, 0xe6, 0x91, 0x90, 0x1f, 0xa1, 0xbe, 0x78, 0xc8, 0x9b,
+    0xa2, 0x90, 0x5f, 0x41, 0x7d, 0x71, 0x90, 0x97, 0xac, 0x90, 0x9f, 0x45,
+    0x7d, 0xc1, 0xfb, 0x48, 0x49, 0xc8, 0xcf, 0x81, 0xbe, 0x10, 0xde, 0x47,
+    0xf6, 0x42, 0x7e, 0x1e, 0xf4, 0x85, 0xf0, 0x3e, 0x32, 0x09, 0xf9, 0x05,
+    0xd0, 0x17, 0xc2, 0xfb, 0xa0, 0x28, 0xe4, 0x17, 0x41, 0x5f, 0x08, 0xef,
+    0xa3, 0x58, 0x21, 0xbf, 0x09, 0xf4, 0x85, 0xf0, 0x3e, 0x4a, 0x12, 0xf2,
+    0x4b, 0xa0, 0x2f, 0x04, 0xf7, 0xe1, 0xac, 0x17, 0xf2, 0xcb, 0xa0, 0x2f,
+    0x14, 0x30, 0x8f, 0x84, 0xfc, 0x08, 0xf5, 0x05, 0xee, 0xc3, 0xb9, 0x28,
+    0xe4, 0x57, 0x50, 0x5f, 0xe0, 0x3e, 0xfa, 0xef, 0x79, 0xd5, 0x1f, 0x37,
+    0x7d, 0xb1, 0x98, 0xb7, 0xee, 0x0f, 0xde, 0x97, 0x0c, 0xf7, 0xe1, 0xc2,
+    0xba, 0x3f, 0x78, 0x5f, 0x32, 0x61, 0xde, 0xba, 0x3f, 0x78, 0x5f, 0xf2,
+    0xed, 0x3e, 0x9e, 0xae, 0x17, 0x75, 0xb4, 0x3a, 0x5a, 0x1d, 0xad, 0x8e,
+    0x56, 0x47, 0xab, 0xa3, 0xd5, 0xd1, 0xea, 0x68, 0x75, 0xb4, 0x3a, 0x5a,
+    0x1d, 0xad, 0x8e, 0x56, 0x47, 0xab, 0xa3, 0xd5, 0xd1, 0xff, 0x76, 0xf4,
+    0x17, 0x38, 0xa3, 0xad, 0x89, 0xec, 0x16, 0x00, 0x00,
+};
+
+static std::string gzip(const std::string &data) {
+  StdStringPrint out;
+  QuectelDeflater deflater(out);
+  deflater.write((const uint8_t *)data.data(), data.size());
+  deflater.finish();
+  return out.data;
+}
+
+static void queueReplies(FakeModem &sim, const char *method,
+                         const std::string &body, bool encoded) {
+  std::string length = std::to_string(body.size());
+  std::string urc = std::string("+QHTTP") + method + ": 0,200," + length;
+  sim.reset();
+  sim.on("AT+QHTTPCFG").ok();
+  sim.on("AT+QHTTPURL=").raw("\r\nCONNECT\r\n").data(0).ok();
+  if (method[0] == 'P')
+    sim.on("AT+QHTTPPOST=").raw("\r\nCONNECT\r\n").data(0).ok().urc(0, urc);
+  else
+    sim.on("AT+QHTTPGET=").ok().urc(0, urc);
+  std::string headers;
+  if (encoded)
+    headers = "HTTP/1.1 200 OK\r\nContent-Encoding: gzip\r\n"
+              "Content-Length: " + length + "\r\n\r\n";
+  sim.on("AT+QHTTPREAD=")
+      .raw("\r\nCONNECT\r\n" + headers + body +
+           "\r\nOK\r\n\r\n+QHTTPREAD: 0\r\n");
+}
+
+int main(int argc, char **argv) {
+  unsigned long requests = argc > 1 ? strtoul(argv[1], nullptr, 10) : 10;
+  std::string batch = telemetry();
+  std::string document;
+  while (document.size() < 4096)
+    document += batch;
+  std::string packedDocument = gzip(document);
+  size_t urlLength = strlen(URL);
+
+  FakeModem sim(115200);
+  QuectelEC200U modem(sim);
+  modem.setReadWaitMode(ReadWaitMode::SPIN_YIELD);
+  String out;
+  bool ok = true;
+
+  benchPrintHeader("JSON telemetry POST, 115200 baud");
+  for (int compressed = 0; compressed < 2; compressed++) {
+    modem.setHttpCompression(compressed, false);
+    queueReplies(sim, "POST", "{\"ok\":true}", false);
+    BenchResult r = bench(
+        compressed ? "httpPost gzip" : "httpPost", batch.size(), [] {},
+        [&] { ok = modem.httpPost(URL, batch.c_str(), out) && ok; },
+        requests, 0);
+    benchPrint(r);
+    printf("  body B/req %zu (of %zu)\n",
+           sim.payload().size() / r.iterations - urlLength, batch.size());
+  }
+
+  std::string fixture((const char *)GZIP9_DOCUMENT, sizeof(GZIP9_DOCUMENT));
+  const char *names[] = {"httpGet", "httpGet gzip", "httpGet gzip -9"};
+  const std::string *bodies[] = {&document, &packedDocument, &fixture};
+
+  benchPrintHeader("4 KB JSON GET, 115200 baud");
+  for (int i = 0; i < 3; i++) {
+    bool compressed = i > 0;
+    modem.setHttpCompression(false, compressed);
+    queueReplies(sim, "GET", *bodies[i], compressed);
+    BenchResult r = bench(
+        names[i], document.size(), [] {},
+        [&] {
+          ok = modem.httpGet(URL, out) &&
+               std::string(out.c_str(), out.length()) == document && ok;
+        },
+        requests, 0);
+    benchPrint(r);
+    printf("  body B/req %zu, UART B/req %zu\n", bodies[i]->size(),
+           sim.bytesSent() / r.iterations);
+  }
+  if (!ok)
+    printf("decoded body mismatch\n");
+  return ok ? 0 : 1;
+}
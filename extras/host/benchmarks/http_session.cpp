@@ -0,0 +1,135 @@
+/*
+  HTTP request throughput benchmark.
+
+  Posts a small telemetry JSON body repeatedly against the simulated modem
+  at 115200 baud with a per-command modem latency and a 50 ms server round
+  trip. Each request first takes a 5 ms sensor sample to build its body.
+  Reports AT commands and wall time per request:
+
+    httpsPost           QuectelEC200U::httpsPost, full configuration per call
+    QuectelHttpClient   session that only re-sends changed QHTTPCFG state
+    batch               QuectelHttpClient::batch, sampling the next body while
+                        the previous +QHTTPPOST URC is pending
+
+  Every row reads each reply with AT+QHTTPREAD, so the rows are comparable.
+
+  usage: bench_http_session [latency_us]
+*/
+
+#include <QuectelEC200U.h>
+#include <QuectelHttpClient.h>
+
+#include "Bench.h"
+#include "FakeModem.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+
+static const char *URL =
+    "https://api.consentiumiot.com/updateData?key=0123456789abcdef&boardkey=42";
+static const char *BODY = "{\"sensors\":{\"sensorData\":[{\"info\":\"Temperature"
+                          "\",\"data\":\"%d.5\"}]},\"boardInfo\":{\"firmwareVe"
+                          "rsion\":\"0.1\",\"architecture\":\"ESP32\"}}";
+static const unsigned long N = 20;
+
+static char body[160];
+static int samples;
+
+// Stands in for reading a sensor and serialising the payload
+static void sample() {
+  delay(5);
+  snprintf(body, sizeof(body), BODY, 20 + samples++ % 10);
+}
+
+struct Feed {
+  Feed()
+      : sinks{QuectelStringSink(replies[0]), QuectelStringSink(replies[1])},
+        issued(0) {}
+  QuectelHttpRequest slots[2];
+  String replies[2];
+  QuectelStringSink sinks[2];
+  unsigned long issued;
+};
+
+static QuectelHttpRequest *produce(void *arg) {
+  Feed *feed = static_cast<Feed *>(arg);
+  if (feed->issued == N) {
+    return nullptr;
+  }
+  // The previous body is already on the modem, so one buffer is enough
+  sample();
+  size_t slot = feed->issued++ % 2;
+  QuectelHttpRequest *request = &feed->slots[slot];
+  request->url = URL;
+  request->data = body;
+  feed->replies[slot] = "";
+  request->response = &feed->sinks[slot];
+  return request;
+}
+
+static void queueReplies(FakeModem &sim) {
+  sim.reset();
+  sim.on("AT+QHTTPCFG").ok();
+  sim.on("AT+QHTTPURL=").raw("\r\nCONNECT\r\n").data(0).ok();
+  sim.on("AT+QHTTPPOST=")
+      .raw("\r\nCONNECT\r\n")
+      .data(0)
+      .ok()
+      .urc(50, "+QHTTPPOST: 0,200,15");
+  sim.on("AT+QHTTPREAD=")
+      .raw("\r\nCONNECT\r\n{\"status\":\"ok\"}\r\nOK\r\n\r\n+QHTTPREAD: 0\r\n");
+}
+
+int main(int argc, char **argv) {
+  uint32_t latencyUs = argc > 1 ? strtoul(argv[1], nullptr, 10) : 2000;
+  FakeModem sim(115200);
+  sim.setLatency(latencyUs);
+  QuectelEC200U modem(sim);
+  modem.setReadWaitMode(ReadWaitMode::SPIN_YIELD);
+  QuectelHttpClient client(modem);
+  String headers[] = {"Content-Type: application/json"};
+  String response;
+  size_t commands = 0;
+
+  benchPrintHeader("telemetry POST, 115200 baud");
+
+  queueReplies(sim);
+  BenchResult plain = bench(
+      "httpsPost", strlen(BODY), [] {},
+      [&] {
+        sample();
+        modem.httpsPost(URL, body, response, headers, 1);
+      },
+      N, 0);
+  commands = sim.commands().size();
+  benchPrint(plain);
+  printf("  %.1f AT commands/request, %.1f requests/s\n",
+         (double)commands / plain.iterations, 1e6 / plain.usPerCall);
+
+  queueReplies(sim);
+  BenchResult session = bench(
+      "QuectelHttpClient", strlen(BODY), [] {},
+      [&] {
+        sample();
+        client.post(URL, body, response, headers, 1);
+      },
+      N, 0);
+  commands = sim.commands().size();
+  benchPrint(session);
+  printf("  %.1f AT commands/request, %.1f requests/s\n",
+         (double)commands / session.iterations, 1e6 / session.usPerCall);
+
+  queueReplies(sim);
+  client.invalidate();
+  Feed feed;
+  size_t succeeded = 0;
+  BenchResult batch = bench(
+      "batch", strlen(BODY), [&] { feed.issued = 0; },
+      [&] { succeeded = client.batch(produce, &feed, headers, 1); }, 1, 0);
+  commands = sim.commands().size();
+  benchPrint(batch);
+  printf("  %zu/%lu ok, %.1f AT commands/request, %.1f requests/s\n",
+         succeeded, N, (double)commands / (batch.iterations * N),
+         1e6 * N / batch.usPerCall);
+  return 0;
+}
@@ -0,0 +1,117 @@
+/*
+  TCP bulk transfer benchmark.
+
+  Moves 14600 bytes (ten full segments) over one socket against the
+  simulated modem at 115200 baud with 5 ms command latency:
+
+    tcpSend upload        buffer access mode, AT+QISEND per 1460 bytes
+    QIRD download         QuectelSocketManager, AT+QIRD per 1460 bytes
+    direct push download  QuectelSocketManager, data pushed with +QIURC
+    transparent download  QuectelTransparentSession, raw bytes
+
+  "UART overhead" is what the AT framing adds to the payload. A transparent
+  upload is the payload alone.
+
+  usage: bench_socket_stream [transfers]
+*/
+
+#include <QuectelEC200U.h>
+#include <QuectelSocketManager.h>
+#include <QuectelTransparentSession.h>
+
+#include "Bench.h"
+#include "FakeModem.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string>
+
+static const size_t SEGMENT = 1460;
+static const size_t SIZE = 10 * SEGMENT;
+
+static std::string payload() {
+  std::string data;
+  for (size_t i = 0; i < SIZE; i++)
+    data += (char)('a' + i % 26);
+  return data;
+}
+
+int main(int argc, char **argv) {
+  unsigned long transfers = argc > 1 ? strtoul(argv[1], nullptr, 10) : 3;
+  std::string data = payload();
+  FakeModem sim(115200);
+  sim.setLatency(5000);
+  QuectelEC200U modem(sim);
+  modem.setReadWaitMode(ReadWaitMode::SPIN_YIELD);
+  static uint8_t buf[SIZE];
+
+  benchPrintHeader("14.6 KB TCP transfer, 115200 baud, 5 ms latency");
+
+  sim.on("AT+QISEND=").raw("\r\n> ").data(1).line("SEND OK");
+  size_t before = sim.bytesReceived();
+  BenchResult send = bench(
+      "tcpSend upload", SIZE, [] {},
+      [&] { modem.tcpSend(0, (const uint8_t *)data.data(), SIZE); },
+      transfers, 0);
+  benchPrint(send);
+  printf("  UART overhead B/transfer %zu\n",
+         (sim.bytesReceived() - before) / send.iterations - SIZE);
+
+  QuectelSocketManager sockets(modem);
+  sockets.begin();
+  sim.on("AT+QIOPEN=").ok().urc(0, "+QIOPEN: 0,0").times(1);
+  sim.on("AT+QIRD=").raw("\r\n+QIRD: 1460\r\n" + data.substr(0, SEGMENT) +
+                         "\r\n\r\nOK\r\n");
+  sim.on("AT+QICLOSE=").ok();
+  int id = sockets.open("stream.example.com", 9000);
+  before = sim.bytesSent();
+  size_t commands = sim.commands().size();
+  BenchResult qird = bench(
+      "QIRD download", SIZE, [] {},
+      [&] {
+        for (size_t got = 0; got < SIZE; got += SEGMENT)
+          sockets.read(id, buf + got, SEGMENT);
+      },
+      transfers, 0);
+  benchPrint(qird);
+  printf("  UART overhead B/transfer %zu, AT commands/transfer %zu\n",
+         (sim.bytesSent() - before) / qird.iterations - SIZE,
+         (sim.commands().size() - commands) / qird.iterations);
+  sockets.close(id);
+
+  std::string pushed;
+  for (size_t off = 0; off < SIZE; off += SEGMENT)
+    pushed += "\r\n+QIURC: \"recv\",0,1460\r\n" + data.substr(off, SEGMENT);
+  sockets.setAccessMode(QuectelAccessMode::DIRECT_PUSH);
+  sim.on("AT+QIOPEN=").ok().urc(0, "+QIOPEN: 0,0").times(1);
+  id = sockets.open("stream.example.com", 9000);
+  before = sim.bytesSent();
+  commands = sim.commands().size();
+  BenchResult push = bench(
+      "direct push download", SIZE, [&] { sim.injectRaw(pushed); },
+      [&] {
+        for (size_t got = 0; got < SIZE;) {
+          int n = sockets.read(id, buf + got, SIZE - got);
+          got += n > 0 ? n : 0;
+        }
+      },
+      transfers, 0);
+  benchPrint(push);
+  printf("  UART overhead B/transfer %zu, AT commands/transfer %zu\n",
+         (sim.bytesSent() - before) / push.iterations - SIZE,
+         (sim.commands().size() - commands) / push.iterations);
+  sockets.close(id);
+
+  QuectelTransparentSession pipe(modem);
+  sim.on("AT+QIOPEN=1,0,\"TCP\"").raw("\r\nCONNECT\r\n");
+  sim.on("+++").ok();
+  pipe.begin("stream.example.com", 9000);
+  before = sim.bytesSent();
+  BenchResult raw = bench(
+      "transparent download", SIZE, [&] { sim.injectRaw(data); },
+      [&] { pipe.readBytes(buf, SIZE); }, transfers, 0);
+  benchPrint(raw);
+  printf("  UART overhead B/transfer %zu\n",
+         (sim.bytesSent() - before) / raw.iterations - SIZE);
+  return !pipe.end();
+}
@@ -0,0 +1,38 @@
+/*
+  Minimal test harness for the host build.
+
+  TEST(name) registers a case; CHECK(cond) records a failure and carries on,
+  so one run reports every broken expectation. host_tests runs all cases
+  (or those whose name contains argv[1]) and exits non-zero on any failure.
+*/
+
+#ifndef QUECTEL_HOST_TEST_H
+#define QUECTEL_HOST_TEST_H
+
+#include <Arduino.h>
+
+#include <string>
+
+typedef void (*HostTestFn)();
+
+struct HostTestCase {
+  HostTestCase(const char *name, HostTestFn fn);
+  const char *name;
+  HostTestFn fn;
+  HostTestCase *next;
+};
+
+void hostCheck(bool ok, const char *expr, const char *file, int line);
+
+inline std::string toStd(const String &s) {
+  return std::string(s.c_str(), s.length());
+}
+
+#define TEST(name)                                                             \
+  static void test_##name();                                                   \
+  static HostTestCase testCase_##name(#name, test_##name);                     \
+  static void test_##name()
+
+#define CHECK(cond) hostCheck((cond), #cond, __FILE__, __LINE__)
+
+#endif
@@ -0,0 +1,75 @@
+// Commands that do not fit MAX_CMD_LENGTH are refused, never sent cut short
+
+#include "FakeModem.h"
+#include "HostTest.h"
+
+#include <QuectelEC200U.h>
+
+namespace {
+struct Done {
+  int calls;
+  bool ok;
+};
+
+void finished(bool ok, const char *, void *arg) {
+  Done *done = static_cast<Done *>(arg);
+  done->calls++;
+  done->ok = ok;
+}
+
+bool sent(const FakeModem &sim, const char *prefix) {
+  for (size_t i = 0; i < sim.commands().size(); i++) {
+    if (sim.commands()[i].compare(0, strlen(prefix), prefix) == 0)
+      return true;
+  }
+  return false;
+}
+
+void runUntil(QuectelEC200U &modem, const Done &done) {
+  uint32_t start = millis();
+  while (done.calls == 0 && millis() - start < 5000)
+    modem.loop();
+}
+} // namespace
+
+TEST(truncated_raw_commands) {
+  FakeModem sim;
+  QuectelEC200U modem(sim);
+  std::string path = "UFS:" + std::string(MAX_CMD_LENGTH, 'a');
+  String response;
+  CHECK(!modem.fsExists(path.c_str()));
+  CHECK(modem.fsOpen(path.c_str()) == -1);
+  CHECK(!modem.sendUSSD(path.c_str(), response));
+  CHECK(modem.getLastError() == ErrorCode::UNKNOWN);
+  CHECK(!modem.sendATRaw(ATCommand("AT+QFLST=\"%s\"", path.c_str())));
+  CHECK(sim.commands().empty());
+}
+
+TEST(truncated_async_commands) {
+  FakeModem sim;
+  QuectelEC200U modem(sim);
+  sim.on("AT+CGATT?").line("+CGATT: 1").ok();
+  sim.on("AT+QIACT?").ok();
+  sim.on("AT+CGDCONT=").ok();
+  sim.on("AT+CGDCONT?").line("+CGDCONT: 1,\"IP\",\"apn\"").ok();
+  sim.on("AT+QICSGP=").ok();
+  std::string longText(MAX_CMD_LENGTH, 'u');
+
+  // APN too long for AT+CGDCONT
+  Done done = {0, true};
+  CHECK(modem.attachDataAsync(longText.c_str(), finished, &done));
+  runUntil(modem, done);
+  CHECK(done.calls == 1 && !done.ok);
+  CHECK(modem.getLastError() == ErrorCode::APN_CONFIG_FAILED);
+  CHECK(!sent(sim, "AT+CGDCONT="));
+
+  // User name too long for AT+QICSGP
+  done.calls = 0;
+  done.ok = true;
+  CHECK(modem.attachDataAsync("apn", finished, &done, longText.c_str(), "p"));
+  runUntil(modem, done);
+  CHECK(done.calls == 1 && !done.ok);
+  CHECK(modem.getLastError() == ErrorCode::AUTH_CONFIG_FAILED);
+  CHECK(sent(sim, "AT+CGDCONT="));
+  CHECK(!sent(sim, "AT+QICSGP="));
+}
@@ -0,0 +1,89 @@
+// QuectelDeflater / QuectelInflater round trip
+
+#include "HostTest.h"
+
+#include <QuectelGzip.h>
+
+#include <stdlib.h>
+
+namespace {
+class StdSink : public Print {
+public:
+  std::string data;
+  size_t write(uint8_t c) override {
+    data += (char)c;
+    return 1;
+  }
+  size_t write(const uint8_t *buf, size_t len) override {
+    data.append((const char *)buf, len);
+    return len;
+  }
+  using Print::write;
+};
+
+std::string deflate(const std::string &plain) {
+  StdSink out;
+  QuectelDeflater deflater(out);
+  deflater.write((const uint8_t *)plain.data(), plain.size());
+  deflater.finish();
+  CHECK(deflater.compressedSize() == out.data.size());
+  return out.data;
+}
+
+// Feeds `packed` in pieces of `step` bytes
+bool inflate(const std::string &packed, std::string &plain, size_t step) {
+  StdSink out;
+  QuectelInflater inflater(out);
+  for (size_t i = 0; i < packed.size(); i += step) {
+    size_t n = packed.size() - i < step ? packed.size() - i : step;
+    inflater.write((const uint8_t *)packed.data() + i, n);
+  }
+  plain = out.data;
+  return inflater.finished() && !inflater.failed();
+}
+
+std::string sample(size_t size, bool random) {
+  std::string s;
+  srand(42);
+  for (size_t i = 0; i < size; i++)
+    s += random ? (char)(rand() & 0xff) : "{\"t\":21.5,\"h\":40}"[i % 17];
+  return s;
+}
+} // namespace
+
+TEST(gzip_round_trip) {
+  std::string inputs[] = {"", "a", "hello hello hello hello",
+                          sample(20000, false), sample(20000, true),
+                          std::string(70000, '\0')};
+  for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++) {
+    std::string packed = deflate(inputs[i]);
+    CHECK(packed.size() >= 18); // gzip header and trailer
+    CHECK((uint8_t)packed[0] == 0x1f && (uint8_t)packed[1] == 0x8b);
+    size_t steps[] = {1, 7, packed.size()};
+    for (size_t s = 0; s < 3; s++) {
+      std::string plain;
+      CHECK(inflate(packed, plain, steps[s] ? steps[s] : 1));
+      CHECK(plain == inputs[i]);
+    }
+  }
+  // Repetitive input actually shrinks
+  CHECK(deflate(sample(20000, false)).size() < 2000);
+}
+
+TEST(gzip_corrupt_stream) {
+  std::string packed = deflate(sample(5000, false));
+  std::string plain;
+  // Bad CRC32 in the trailer
+  std::string badCrc = packed;
+  badCrc[badCrc.size() - 8] ^= 0x01;
+  CHECK(!inflate(badCrc, plain, 64));
+  // Bad magic
+  std::string badMagic = packed;
+  badMagic[0] = 0;
+  CHECK(!inflate(badMagic, plain, 64));
+  // Truncated: not finished, but not failed either
+  StdSink out;
+  QuectelInflater inflater(out);
+  inflater.write((const uint8_t *)packed.data(), packed.size() / 2);
+  CHECK(!inflater.finished());
+}
@@ -0,0 +1,126 @@
+// HTTP response reads with and without the response header block
+// (HttpHeaderSplitter), and QuectelHttpClient header reuse
+
+#include "FakeModem.h"
+#include "HostTest.h"
+
+#include <QuectelEC200U.h>
+#include <QuectelHttpClient.h>
+
+static void httpRules(FakeModem &sim, const std::string &urc,
+                      const std::string &read) {
+  sim.reset();
+  sim.on("AT+QHTTPCFG").ok();
+  sim.on("AT+QHTTPURL=").raw("\r\nCONNECT\r\n").data(0).ok();
+  sim.on("AT+QHTTPGET=").ok().urc(1, urc);
+  sim.on("AT+QHTTPREAD=")
+      .raw("\r\nCONNECT\r\n" + read + "\r\nOK\r\n\r\n+QHTTPREAD: 0\r\n");
+}
+
+TEST(http_header_split) {
+  FakeModem sim;
+  QuectelEC200U modem(sim);
+  QuectelEC200U::HttpResponse r;
+  httpRules(sim, "+QHTTPGET: 0,200,5",
+            "HTTP/1.1 200 OK\r\nETag: \"abc\"\r\nContent-Length: 5\r\n\r\n"
+            "he\r\nl");
+  CHECK(modem.httpGet("http://example.com/", r, true));
+  CHECK(r.status == 200);
+  CHECK(r.contentLength == 5);
+  CHECK(toStd(r.headers) ==
+        "HTTP/1.1 200 OK\r\nETag: \"abc\"\r\nContent-Length: 5");
+  CHECK(toStd(r.body) == "he\r\nl");
+}
+
+TEST(http_header_split_body_blank_lines) {
+  // A blank line inside the body is body, not the end of the headers
+  FakeModem sim;
+  QuectelEC200U modem(sim);
+  QuectelEC200U::HttpResponse r;
+  std::string body("\r\n\r\nx\0y", 7);
+  httpRules(sim, "+QHTTPGET: 0,200,7", "HTTP/1.1 200 OK\r\nA: b\r\n\r\n" + body);
+  CHECK(modem.httpGet("http://example.com/", r, true));
+  CHECK(toStd(r.headers) == "HTTP/1.1 200 OK\r\nA: b");
+  CHECK(toStd(r.body) == body);
+}
+
+TEST(http_header_split_empty_body) {
+  FakeModem sim;
+  QuectelEC200U modem(sim);
+  QuectelEC200U::HttpResponse r;
+  httpRules(sim, "+QHTTPGET: 0,304,0", "HTTP/1.1 304 Not Modified\r\n\r\n");
+  CHECK(modem.httpGet("http://example.com/", r, true));
+  CHECK(r.status == 304);
+  CHECK(toStd(r.headers) == "HTTP/1.1 304 Not Modified");
+  CHECK(r.body.length() == 0);
+}
+
+TEST(http_plain_body) {
+  FakeModem sim;
+  QuectelEC200U modem(sim);
+  QuectelEC200U::HttpResponse r;
+  httpRules(sim, "+QHTTPGET: 0,200,11", "hello world");
+  CHECK(modem.httpGet("http://example.com/", r));
+  CHECK(toStd(r.body) == "hello world");
+  CHECK(r.headers.length() == 0);
+  // A body that disagrees with the URC's length is an error
+  httpRules(sim, "+QHTTPGET: 0,200,3", "hello world");
+  CHECK(!modem.httpGet("http://example.com/", r));
+}
+
+static void countUrc(const char *, void *arg) { (*static_cast<int *>(arg))++; }
+
+TEST(http_chunked_body_raw) {
+  // Without a length the body is copied raw up to the trailer: lines that
+  // look like URCs or result codes stay in it
+  FakeModem sim;
+  QuectelEC200U modem(sim);
+  QuectelEC200U::HttpResponse r;
+  int urcs = 0;
+  modem.onURC("+QIURC:", countUrc, &urcs);
+  std::string body("a\r\nOK\r\n+QIURC: \"recv\",0\r\n+CME ERROR: 3\r\nz\0", 42);
+  httpRules(sim, "+QHTTPGET: 0,200", body);
+  sim.on("AT+B").line("+B: 1").ok();
+  CHECK(modem.httpGet("http://example.com/", r));
+  CHECK(r.contentLength == -1);
+  CHECK(toStd(r.body) == body);
+  CHECK(urcs == 0);
+  // The trailer's line end does not lead the next reply
+  char next[32];
+  QuectelBufferSink sink(next, sizeof(next));
+  CHECK(modem.sendAT("AT+B", sink));
+  CHECK(strncmp(next, "\r\n+B: 1", 7) == 0);
+}
+
+TEST(http_client_header_reuse) {
+  // Header lines are compared exactly: "costarring" and "liquid" share a
+  // 32-bit FNV-1a hash
+  FakeModem sim;
+  QuectelEC200U modem(sim);
+  QuectelHttpClient http(modem);
+  httpRules(sim, "+QHTTPGET: 0,200,2", "ok");
+  String first[] = {"costarring"};
+  String second[] = {"liquid"};
+  String twice[] = {"liquid", "liquid"};
+  String response;
+  struct {
+    String *headers;
+    size_t count;
+    bool resent;
+  } steps[] = {
+      {first, 1, true},   {first, 1, false}, {second, 1, true},
+      {second, 1, false}, {twice, 2, true},  {twice, 1, true},
+      {nullptr, 0, true}, {nullptr, 0, false},
+  };
+  for (size_t i = 0; i < sizeof(steps) / sizeof(steps[0]); i++) {
+    size_t before = sim.commands().size();
+    CHECK(http.get("http://example.com/", response, steps[i].headers,
+                   steps[i].count));
+    bool resent = false;
+    for (size_t c = before; c < sim.commands().size(); c++) {
+      if (sim.commands()[c].find("requestheader") != std::string::npos)
+        resent = true;
+    }
+    CHECK(resent == steps[i].resent);
+  }
+}
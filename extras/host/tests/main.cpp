@@ -0,0 +1,37 @@
+#include "HostTest.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static HostTestCase *cases = nullptr;
+static HostTestCase **tail = &cases;
+static int failures;
+
+HostTestCase::HostTestCase(const char *name, HostTestFn fn)
+    : name(name), fn(fn), next(nullptr) {
+  *tail = this;
+  tail = &next;
+}
+
+void hostCheck(bool ok, const char *expr, const char *file, int line) {
+  if (!ok) {
+    printf("  FAIL %s:%d: %s\n", file, line, expr);
+    failures++;
+  }
+}
+
+int main(int argc, char **argv) {
+  int run = 0, failed = 0;
+  for (HostTestCase *t = cases; t != nullptr; t = t->next) {
+    if (argc > 1 && strstr(t->name, argv[1]) == nullptr)
+      continue;
+    int before = failures;
+    t->fn();
+    run++;
+    if (failures != before)
+      failed++;
+    printf("%s %s\n", failures == before ? "ok  " : "FAIL", t->name);
+  }
+  printf("%d/%d passed\n", run - failed, run);
+  return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,68 @@
+// Parsers that search the reply for the final "\r\nOK\r\n"
+
+#include "FakeModem.h"
+#include "HostTest.h"
+
+#include <QuectelEC200U.h>
+
+TEST(final_result_lf_consumed) {
+  FakeModem sim;
+  QuectelEC200U modem(sim);
+  sim.on("AT+A").line("+A: 1").ok();
+  sim.on("AT+B").line("+B: 2").ok();
+  char buf[64];
+  QuectelBufferSink sink(buf, sizeof(buf));
+  CHECK(modem.sendAT("AT+A", sink));
+  CHECK(std::string(buf).size() >= 6);
+  CHECK(std::string(buf).substr(std::string(buf).size() - 6) == "\r\nOK\r\n");
+  CHECK(sim.available() == 0);
+
+  // Nothing of the previous reply is left for the next one
+  char next[64];
+  QuectelBufferSink nextSink(next, sizeof(next));
+  CHECK(modem.sendAT("AT+B", nextSink));
+  CHECK(next[0] == '\r');
+  CHECK(strstr(next, "+B: 2\r\n\r\nOK\r\n") != nullptr);
+  CHECK(sim.available() == 0);
+}
+
+TEST(parse_read_sms) {
+  FakeModem sim;
+  QuectelEC200U modem(sim);
+  sim.on("AT+CMGR=1")
+      .line("+CMGR: \"REC READ\",\"+15550100\",,\"26/10/18,12:00:00+00\"")
+      .line("hello there")
+      .ok();
+  sim.on("AT+CMGR=2")
+      .line("+CMGR: \"REC READ\",\"+15550100\",,\"26/10/18,12:00:00+00\"")
+      .line("00480069")
+      .ok();
+  sim.on("AT+CMGR=3").ok();
+  CHECK(toStd(modem.readSMS(1)) == "hello there");
+  CHECK(toStd(modem.readSMS(2)) == "Hi");
+  CHECK(modem.readSMS(3).length() == 0);
+  CHECK(sim.available() == 0);
+}
+
+TEST(parse_fs_list) {
+  FakeModem sim;
+  QuectelEC200U modem(sim);
+  sim.on("AT+QFLST").raw("\r\n+QFLST: \"UFS:a.txt\",12\r\n"
+                         "+QFLST: \"UFS:b.bin\",3400\r\n\r\nOK\r\n");
+  String list;
+  CHECK(modem.fsList(list));
+  CHECK(toStd(list) ==
+        "+QFLST: \"UFS:a.txt\",12\r\n+QFLST: \"UFS:b.bin\",3400\r\n");
+  CHECK(sim.available() == 0);
+}
+
+TEST(parse_call_list) {
+  FakeModem sim;
+  QuectelEC200U modem(sim);
+  sim.on("AT+CLCC").line("+CLCC: 1,0,0,0,0,\"+15550100\",145").ok().times(1);
+  sim.on("AT+CLCC").ok();
+  CHECK(toStd(modem.getCallList()) ==
+        "+CLCC: 1,0,0,0,0,\"+15550100\",145\r\n");
+  CHECK(modem.getCallList().length() == 0);
+  CHECK(sim.available() == 0);
+}
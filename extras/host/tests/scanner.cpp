@@ -0,0 +1,78 @@
+// ATLineScanner result codes and sendAT termination
+
+#include "FakeModem.h"
+#include "HostTest.h"
+
+#include <QuectelEC200U.h>
+
+static ATResult scan(ATLineScanner &scanner, const char *bytes) {
+  ATResult last = AT_PENDING;
+  for (const char *p = bytes; *p; p++) {
+    ATResult r = scanner.feed(*p);
+    if (r != AT_PENDING)
+      last = r;
+  }
+  return last;
+}
+
+TEST(scanner_result_codes) {
+  struct {
+    const char *bytes;
+    ATResult result;
+  } cases[] = {
+      {"\r\nOK\r\n", AT_OK},
+      {"\r\nERROR\r\n", AT_ERROR},
+      {"\r\n+CME ERROR: 10\r\n", AT_CME_ERROR},
+      {"\r\n+CMS ERROR: 500\r\n", AT_CMS_ERROR},
+      {"\r\nCONNECT\r\n", AT_CONNECT},
+      {"\r\nCONNECT 1024\r\n", AT_CONNECT},
+      {"\r\nSEND OK\r\n", AT_SEND_OK},
+      {"\r\nSEND FAIL\r\n", AT_SEND_FAIL},
+      {"\r\n> ", AT_PROMPT},
+      {"\r\nOKAY\r\n", AT_PENDING},
+      {"\r\nCONNECTED\r\n", AT_PENDING},
+      {"\r\n+CSQ: 23,99\r\n", AT_PENDING},
+      {"\r\nNO CARRIER\r\n", AT_PENDING},
+  };
+  for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+    ATLineScanner scanner;
+    CHECK(scan(scanner, cases[i].bytes) == cases[i].result);
+    CHECK(scanner.result() == cases[i].result);
+  }
+}
+
+TEST(scanner_result_line) {
+  ATLineScanner scanner;
+  CHECK(scan(scanner, "\r\n+CSQ: 23,99\r\n\r\n+CME ERROR: 50\r\n") ==
+        AT_CME_ERROR);
+  CHECK(strcmp(scanner.resultLine(), "+CME ERROR: 50") == 0);
+  // The result is reported on the byte that completes the line
+  ATLineScanner byByte;
+  CHECK(byByte.feed('O') == AT_PENDING);
+  CHECK(byByte.feed('K') == AT_PENDING);
+  CHECK(byByte.feed('\r') == AT_OK);
+  CHECK(byByte.feed('\n') == AT_PENDING);
+}
+
+TEST(scanner_long_line) {
+  // Lines past the buffer are still classified by their start
+  std::string line(QUECTEL_LINE_BUFFER_SIZE * 3, 'x');
+  ATLineScanner scanner;
+  CHECK(scan(scanner, ("\r\n" + line + "\r\nOK\r\n").c_str()) == AT_OK);
+}
+
+TEST(sendat_results) {
+  FakeModem sim;
+  QuectelEC200U modem(sim);
+  sim.on("AT+A").ok();
+  sim.on("AT+B").error();
+  sim.on("AT+C").line("+CME ERROR: 3");
+  sim.on("AT+D").line("+D: 1").ok();
+  CHECK(modem.sendAT("AT+A"));
+  CHECK(!modem.sendAT("AT+B"));
+  CHECK(!modem.sendAT("AT+C"));
+  char buf[64];
+  QuectelBufferSink sink(buf, sizeof(buf));
+  CHECK(modem.sendAT("AT+D", sink));
+  CHECK(strstr(buf, "+D: 1") != nullptr);
+}
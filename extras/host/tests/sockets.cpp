@@ -0,0 +1,94 @@
+// QuectelSocketManager state table
+
+#include "FakeModem.h"
+#include "HostTest.h"
+
+#include <QuectelEC200U.h>
+#include <QuectelSocketManager.h>
+
+static void socketRules(FakeModem &sim) {
+  sim.on("AT+QIOPEN=1,0,").ok().urc(0, "+QIOPEN: 0,0");
+  sim.on("AT+QIOPEN=1,1,").ok().urc(0, "+QIOPEN: 1,0");
+  sim.on("AT+QIOPEN=1,2,").ok().urc(0, "+QIOPEN: 2,566");
+  sim.on("AT+QICLOSE=").ok();
+}
+
+TEST(sockets_open_close) {
+  FakeModem sim;
+  QuectelEC200U modem(sim);
+  QuectelSocketManager sockets(modem);
+  CHECK(sockets.begin());
+  socketRules(sim);
+  for (int id = 0; id < QUECTEL_MAX_SOCKETS; id++)
+    CHECK(sockets.state(id) == QuectelSocketState::FREE);
+  CHECK(sockets.open("a.example.com", 80) == 0);
+  CHECK(sockets.open("b.example.com", 80) == 1);
+  CHECK(sockets.state(0) == QuectelSocketState::OPEN);
+  CHECK(sockets.state(1) == QuectelSocketState::OPEN);
+  CHECK(sockets.openCount() == 2);
+  // A refused open leaves its ID free
+  CHECK(sockets.open("c.example.com", 80) == -1);
+  CHECK(sockets.state(2) == QuectelSocketState::FREE);
+  CHECK(sockets.close(0));
+  CHECK(sockets.state(0) == QuectelSocketState::FREE);
+  CHECK(sockets.openCount() == 1);
+  CHECK(sockets.state(-1) == QuectelSocketState::FREE);
+  CHECK(sockets.state(QUECTEL_MAX_SOCKETS) == QuectelSocketState::FREE);
+}
+
+TEST(sockets_urcs) {
+  FakeModem sim;
+  QuectelEC200U modem(sim);
+  QuectelSocketManager sockets(modem);
+  sockets.begin();
+  socketRules(sim);
+  CHECK(sockets.open("a.example.com", 80) == 0);
+  CHECK(sockets.open("b.example.com", 80) == 1);
+  CHECK(sockets.available() == -1);
+
+  sim.inject("+QIURC: \"recv\",1");
+  sim.inject("+QIURC: \"recv\",0");
+  sim.inject("+QIURC: \"recv\",5"); // not ours
+  sockets.poll();
+  CHECK(sockets.hasData(0));
+  CHECK(sockets.hasData(1));
+  CHECK(!sockets.hasData(5));
+  int first = sockets.available();
+  int second = sockets.available();
+  CHECK(first != -1 && second != -1 && first != second);
+
+  sim.inject("+QIURC: \"closed\",1");
+  sockets.poll();
+  CHECK(sockets.state(1) == QuectelSocketState::CLOSED);
+  CHECK(sockets.state(0) == QuectelSocketState::OPEN);
+  // CLOSED is not open but keeps its ID until close()
+  CHECK(sockets.openCount() == 1);
+  CHECK(sockets.open("c.example.com", 80) != 1);
+  CHECK(sockets.close(1));
+  CHECK(sockets.state(1) == QuectelSocketState::FREE);
+
+  sim.inject("+QIURC: \"pdpdeact\",1");
+  sockets.poll();
+  CHECK(sockets.state(0) == QuectelSocketState::CLOSED);
+  sockets.closeAll();
+  CHECK(sockets.openCount() == 0);
+}
+
+TEST(sockets_buffer_read) {
+  FakeModem sim;
+  QuectelEC200U modem(sim);
+  QuectelSocketManager sockets(modem);
+  sockets.begin();
+  socketRules(sim);
+  CHECK(sockets.open("a.example.com", 80) == 0);
+  sim.on("AT+QIRD=0").raw("\r\n+QIRD: 5\r\nhello\r\n\r\nOK\r\n").times(1);
+  sim.on("AT+QIRD=0").raw("\r\n+QIRD: 0\r\n\r\nOK\r\n");
+  sim.inject("+QIURC: \"recv\",0");
+  sockets.poll();
+  uint8_t buf[16];
+  CHECK(sockets.read(0, buf, sizeof(buf)) == 5);
+  CHECK(memcmp(buf, "hello", 5) == 0);
+  CHECK(sockets.read(0, buf, sizeof(buf)) == 0);
+  CHECK(!sockets.hasData(0));
+  CHECK(sockets.read(3, buf, sizeof(buf)) == -1);
+}
@@ -0,0 +1,44 @@
+// Nothing reaches the modem as a command while a transparent session is open
+
+#include "FakeModem.h"
+#include "HostTest.h"
+
+#include <QuectelEC200U.h>
+#include <QuectelSocketManager.h>
+#include <QuectelTransparentSession.h>
+
+TEST(transparent_blocks_commands) {
+  FakeModem sim;
+  QuectelEC200U modem(sim);
+  QuectelSocketManager sockets(modem);
+  QuectelTransparentSession pipe(modem);
+  sockets.begin();
+  sim.on("AT+QIOPEN=1,0,").ok().urc(0, "+QIOPEN: 0,0");
+  sim.on("AT+QIOPEN=1,1,").raw("\r\nCONNECT\r\n");
+  sim.on("AT+QICLOSE=").ok();
+  sim.on("+++").ok();
+  CHECK(sockets.open("a.example.com", 80) == 0);
+  CHECK(pipe.begin("b.example.com", 80, 1));
+
+  size_t sent = sim.commands().size();
+  sim.injectRaw("peer data\r\nOK\r\n");
+  CHECK(!modem.sendAT("AT"));
+  CHECK(!modem.sendATRaw("AT"));
+  CHECK(!modem.sendATRaw(F("AT")));
+  CHECK(modem.getIMEI().length() == 0);
+  CHECK(modem.readSMS(1).length() == 0);
+  String list;
+  CHECK(!modem.fsList(list));
+  CHECK(modem.readResponse(100).length() == 0);
+  uint8_t buf[8];
+  sim.inject("+QIURC: \"recv\",0");
+  CHECK(sockets.read(0, buf, sizeof(buf)) == -1);
+  CHECK(modem.getLastError() == ErrorCode::TCP_ERROR);
+  CHECK(sim.commands().size() == sent);
+  // The peer's bytes are still there for the session
+  CHECK(pipe.available() > 0);
+
+  CHECK(pipe.suspend());
+  CHECK(modem.sendATRaw("AT"));
+  CHECK(sim.commands().size() == sent + 2);
+}
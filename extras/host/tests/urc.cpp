@@ -0,0 +1,121 @@
+// URC dispatch inside and outside command replies, and payload hold
+
+#include "FakeModem.h"
+#include "HostTest.h"
+
+#include <QuectelEC200U.h>
+
+namespace {
+struct Seen {
+  int calls;
+  std::string line;
+};
+
+void record(const char *line, void *arg) {
+  Seen *seen = static_cast<Seen *>(arg);
+  seen->calls++;
+  seen->line = line;
+}
+
+class StdSink : public Print {
+public:
+  std::string data;
+  size_t write(uint8_t c) override {
+    data += (char)c;
+    return 1;
+  }
+  using Print::write;
+};
+
+struct Payload {
+  QuectelEC200U *modem;
+  StdSink sink;
+  int calls;
+};
+
+// "+DATA: <len>" followed by <len> raw bytes
+void withPayload(const char *line, void *arg) {
+  Payload *p = static_cast<Payload *>(arg);
+  p->calls++;
+  p->modem->urcPayload((size_t)atoi(line + 7), p->sink);
+}
+} // namespace
+
+TEST(urc_dispatched_from_reply) {
+  FakeModem sim;
+  QuectelEC200U modem(sim);
+  Seen sms = {0, ""};
+  CHECK(modem.onURC("+CMTI:", record, &sms));
+  sim.on("AT+CSQ").line("+CSQ: 23,99").line("+CMTI: \"SM\",3").ok();
+  char buf[128];
+  QuectelBufferSink sink(buf, sizeof(buf));
+  CHECK(modem.sendAT("AT+CSQ", sink));
+  CHECK(sms.calls == 1);
+  CHECK(sms.line == "+CMTI: \"SM\",3");
+  // The URC is taken out of the reply
+  CHECK(strstr(buf, "+CSQ: 23,99") != nullptr);
+  CHECK(strstr(buf, "+CMTI") == nullptr);
+}
+
+TEST(urc_poll_and_remove) {
+  FakeModem sim;
+  QuectelEC200U modem(sim);
+  Seen ring = {0, ""};
+  CHECK(modem.onURC("RING", record, &ring));
+  sim.inject("RING");
+  sim.inject("+RINGBACK x");
+  modem.poll();
+  CHECK(ring.calls == 1);
+  CHECK(modem.removeURC("RING"));
+  sim.inject("RING");
+  modem.poll();
+  CHECK(ring.calls == 1);
+}
+
+TEST(urc_prefix_released_to_reader) {
+  FakeModem sim;
+  QuectelEC200U modem(sim);
+  Seen ring = {0, ""};
+  modem.onURC("RING", record, &ring);
+  // Starts like the prefix but diverges: the bytes go back to the reply
+  sim.on("AT+X").raw("\r\nRIN").ok();
+  char buf[64];
+  QuectelBufferSink sink(buf, sizeof(buf));
+  CHECK(modem.sendAT("AT+X", sink));
+  CHECK(strstr(buf, "RIN") != nullptr);
+  CHECK(ring.calls == 0);
+}
+
+TEST(urc_solicited_passes_through) {
+  FakeModem sim;
+  QuectelEC200U modem(sim);
+  Seen open = {0, ""};
+  modem.onURC("+QIOPEN:", record, &open);
+  sim.on("AT+QIOPEN=").ok().urc(5, "+QIOPEN: 0,0");
+  // tcpOpen waits for its own +QIOPEN, which is not dispatched
+  CHECK(modem.tcpOpen("example.com", 80, 1, 0) == 0);
+  CHECK(open.calls == 0);
+}
+
+TEST(urc_payload_hold) {
+  FakeModem sim;
+  QuectelEC200U modem(sim);
+  Payload p;
+  p.modem = &modem;
+  p.calls = 0;
+  CHECK(modem.onURC("+DATA:", withPayload, &p));
+  // The payload looks like a final result; it must not end the reply
+  std::string bytes("OK\r\n\0x", 6);
+  sim.on("AT+Y").raw("\r\n+DATA: 6\r\n" + bytes).line("+Y: 1").ok();
+  char buf[64];
+  QuectelBufferSink sink(buf, sizeof(buf));
+  CHECK(modem.sendAT("AT+Y", sink));
+  CHECK(p.calls == 1);
+  CHECK(p.sink.data == bytes);
+  CHECK(strstr(buf, "+Y: 1") != nullptr);
+  // Same outside a command
+  sim.injectRaw("\r\n+DATA: 3\r\nabc");
+  modem.poll();
+  CHECK(p.calls == 2);
+  CHECK(p.sink.data == bytes + "abc");
+}
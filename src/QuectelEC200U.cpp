@@ -11,11 +11,22 @@
 */
 
 #include "QuectelEC200U.h"
+#include "QuectelGzip.h"
 #include <ArduinoJson.h>
+#include <stdarg.h>
+
+// Serializes public methods once the ESP32 worker is running
+#if defined(QUECTEL_HAS_WORKER)
+#define QUECTEL_LOCK() LockGuard _quectelLock(*this)
+#else
+#define QUECTEL_LOCK() do { } while (0)
+#endif
 
 #if defined(QUECTEL_HAS_HARDWARE_SERIAL)
 QuectelEC200U::QuectelEC200U(HardwareSerial &serial, uint32_t baud,
-                             int8_t rxPin, int8_t txPin) {
+                             int8_t rxPin, int8_t txPin)
+    : _asyncSink(_asyncResponse, sizeof(_asyncResponse)),
+      _opBodySink(_opBody) {
   _serial = &serial;
   _hwSerial = &serial;
   _debugSerial = nullptr;
@@ -29,10 +40,39 @@ QuectelEC200U::QuectelEC200U(HardwareSerial &serial, uint32_t baud,
   _networkRegistered = false;
   _historyCount = 0;
   _historyIndex = 0;
+  _readWaitMode = ReadWaitMode::RTOS_NOTIFY;
+  _pollIntervalMs = QUECTEL_READ_POLL_INTERVAL_MS;
+  _yieldHook = nullptr;
+  _expectSeen = false;
+  _lfDue = false;
+  _asyncHead = 0;
+  _asyncCount = 0;
+  _asyncActive = false;
+  _asyncReading = false;
+  _opPending = false;
+  _opHttpCallback = nullptr;
+  _httpEpoch = 0;
+  _responseHeaderOn = false;
+  _httpCompressRequests = false;
+  _httpAcceptCompressed = false;
+  _transparent = false;
+  _httpStatus = -1;
+  _httpContentLength = -1;
+#if defined(QUECTEL_HAS_WORKER)
+  _rxWaiter = nullptr;
+  _mutex = nullptr;
+  _rxTask = nullptr;
+  _rxBuffer = nullptr;
+#endif
+#if defined(QUECTEL_HAS_RX_NOTIFY)
+  _rxNotifyAttached = false;
+#endif
 }
 #endif
 
-QuectelEC200U::QuectelEC200U(Stream &stream) {
+QuectelEC200U::QuectelEC200U(Stream &stream)
+    : _asyncSink(_asyncResponse, sizeof(_asyncResponse)),
+      _opBodySink(_opBody) {
   _serial = &stream;
   _hwSerial = nullptr;
   _debugSerial = nullptr;
@@ -46,6 +86,33 @@ QuectelEC200U::QuectelEC200U(Stream &stream) {
   _networkRegistered = false;
   _historyCount = 0;
   _historyIndex = 0;
+  _readWaitMode = ReadWaitMode::SPIN_YIELD;
+  _pollIntervalMs = QUECTEL_READ_POLL_INTERVAL_MS;
+  _yieldHook = nullptr;
+  _expectSeen = false;
+  _lfDue = false;
+  _asyncHead = 0;
+  _asyncCount = 0;
+  _asyncActive = false;
+  _asyncReading = false;
+  _opPending = false;
+  _opHttpCallback = nullptr;
+  _httpEpoch = 0;
+  _responseHeaderOn = false;
+  _httpCompressRequests = false;
+  _httpAcceptCompressed = false;
+  _transparent = false;
+  _httpStatus = -1;
+  _httpContentLength = -1;
+#if defined(QUECTEL_HAS_WORKER)
+  _rxWaiter = nullptr;
+  _mutex = nullptr;
+  _rxTask = nullptr;
+  _rxBuffer = nullptr;
+#endif
+#if defined(QUECTEL_HAS_RX_NOTIFY)
+  _rxNotifyAttached = false;
+#endif
 }
 
 // ... (rest of the file) ...
@@ -64,6 +131,237 @@ void QuectelEC200U::enableDebug(Stream &debugStream) {
   _debugSerial = &debugStream;
 }
 
+void QuectelEC200U::setReadWaitMode(ReadWaitMode mode,
+                                    uint16_t pollIntervalMs) {
+  QUECTEL_LOCK();
+  _readWaitMode = mode;
+  _pollIntervalMs = pollIntervalMs > 0 ? pollIntervalMs : 1;
+#if defined(QUECTEL_HAS_RX_NOTIFY)
+  if (mode == ReadWaitMode::RTOS_NOTIFY && _initialized) {
+    _attachRxNotify();
+  }
+#endif
+}
+
+void QuectelEC200U::setYieldHook(void (*hook)()) { _yieldHook = hook; }
+
+#if defined(QUECTEL_HAS_RX_NOTIFY)
+void QuectelEC200U::_attachRxNotify() {
+  if (_rxNotifyAttached || !_hwSerial) {
+    return;
+  }
+  // Runs in the UART event task whenever bytes land in the RX buffer. In
+  // worker mode the RX task is woken and forwards the wake-up to readers.
+  _hwSerial->onReceive([this]() {
+    TaskHandle_t waiter = _rxTask ? _rxTask : _rxWaiter;
+    if (waiter) {
+      xTaskNotifyGive(waiter);
+    }
+  });
+  _rxNotifyAttached = true;
+}
+#endif
+
+// Wait until the modem has sent something, or at most maxWaitMs.
+void QuectelEC200U::_waitForData(uint32_t maxWaitMs) {
+  if (maxWaitMs == 0 || _serial->available()) {
+    return;
+  }
+  uint32_t waitMs = maxWaitMs < _pollIntervalMs ? maxWaitMs : _pollIntervalMs;
+
+  switch (_readWaitMode) {
+  case ReadWaitMode::POLL_DELAY:
+    delay(waitMs);
+    return;
+  case ReadWaitMode::RTOS_NOTIFY:
+#if defined(QUECTEL_HAS_WORKER)
+#if defined(QUECTEL_HAS_RX_NOTIFY)
+    if (_rxNotifyAttached || _rxTask) {
+#else
+    if (_rxTask) {
+#endif
+      _rxWaiter = xTaskGetCurrentTaskHandle();
+      // Re-check after publishing the waiter so a byte that arrived in
+      // between is not missed; a stale notification only causes an early
+      // wake-up.
+      if (!_serial->available()) {
+        TickType_t ticks = pdMS_TO_TICKS(waitMs);
+        ulTaskNotifyTake(pdTRUE, ticks > 0 ? ticks : 1);
+      }
+      _rxWaiter = nullptr;
+      return;
+    }
+#endif
+    // No RX notification available: spin instead.
+    break;
+  case ReadWaitMode::SPIN_YIELD:
+    break;
+  }
+
+  if (_yieldHook) {
+    _yieldHook();
+  } else {
+    yield();
+  }
+}
+
+// Writes straight from the caller's buffer, never more than the UART TX
+// buffer has room for, and runs the yield hook while it drains (or while
+// hardware flow control holds it). Streams that report no room at the
+// start (availableForWrite() == 0) get one plain write. Gives up after
+// 5 s without progress.
+size_t QuectelEC200U::_writePaced(const uint8_t *data, size_t length) {
+  if (_serial->availableForWrite() <= 0) {
+    return _serial->write(data, length);
+  }
+  size_t total = 0;
+  uint32_t lastProgress = millis();
+  while (total < length) {
+    int room = _serial->availableForWrite();
+    size_t n = 0;
+    if (room > 0) {
+      n = length - total < (size_t)room ? length - total : (size_t)room;
+      n = _serial->write(data + total, n);
+    }
+    if (n > 0) {
+      total += n;
+      lastProgress = millis();
+      continue;
+    }
+    if (millis() - lastProgress > 5000) {
+      break;
+    }
+    if (_yieldHook) {
+      _yieldHook();
+    } else {
+      yield();
+    }
+  }
+  return total;
+}
+
+#if defined(QUECTEL_HAS_WORKER)
+// ===== Worker mode =====
+int QuectelWorkerStream::available() {
+  return (_peek >= 0 ? 1 : 0) + (int)xStreamBufferBytesAvailable(_rx);
+}
+
+int QuectelWorkerStream::read() {
+  if (_peek >= 0) {
+    int c = _peek;
+    _peek = -1;
+    return c;
+  }
+  uint8_t c;
+  return xStreamBufferReceive(_rx, &c, 1, 0) == 1 ? c : -1;
+}
+
+int QuectelWorkerStream::peek() {
+  if (_peek < 0) {
+    uint8_t c;
+    if (xStreamBufferReceive(_rx, &c, 1, 0) == 1) {
+      _peek = c;
+    }
+  }
+  return _peek;
+}
+
+bool QuectelEC200U::startWorker(UBaseType_t priority, BaseType_t core) {
+  if (_rxTask) {
+    return true;
+  }
+  if (!_hwSerial) {
+    logError(F("Worker mode needs a HardwareSerial"));
+    return false;
+  }
+
+  _rxBuffer = xStreamBufferCreate(QUECTEL_WORKER_RX_BUFFER_SIZE, 1);
+  SemaphoreHandle_t mutex = xSemaphoreCreateRecursiveMutex();
+  if (!_rxBuffer || !mutex) {
+    if (_rxBuffer) vStreamBufferDelete(_rxBuffer);
+    if (mutex) vSemaphoreDelete(mutex);
+    _rxBuffer = nullptr;
+    logError(F("Worker allocation failed"));
+    return false;
+  }
+
+  // Hand the port over to the RX task; readers now use the stream buffer
+  _workerStream.attach(_hwSerial, _rxBuffer);
+  _serial = &_workerStream;
+  _mutex = mutex;
+  if (xTaskCreatePinnedToCore(_rxTaskEntry, "quectel_rx",
+                              QUECTEL_WORKER_STACK_SIZE, this, priority,
+                              &_rxTask, core) != pdPASS) {
+    _rxTask = nullptr;
+    logError(F("Worker task creation failed"));
+    return false;
+  }
+#if defined(QUECTEL_HAS_RX_NOTIFY)
+  _attachRxNotify();
+#endif
+  logDebug(F("Worker task started"));
+  return true;
+}
+
+void QuectelEC200U::lock() {
+  if (_mutex) {
+    xSemaphoreTakeRecursive(_mutex, portMAX_DELAY);
+  }
+}
+
+void QuectelEC200U::unlock() {
+  if (_mutex) {
+    xSemaphoreGiveRecursive(_mutex);
+  }
+}
+
+void QuectelEC200U::_rxTaskEntry(void *arg) {
+  static_cast<QuectelEC200U *>(arg)->_rxLoop();
+}
+
+void QuectelEC200U::_rxLoop() {
+  uint8_t buf[64];
+  while (true) {
+    size_t n = _hwSerial->available();
+    if (n == 0) {
+      // Idle: sleep until the UART reports data (polls each tick without
+      // onReceive support)
+#if defined(QUECTEL_HAS_RX_NOTIFY)
+      ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(_pollIntervalMs));
+#else
+      ulTaskNotifyTake(pdTRUE, 1);
+#endif
+      continue;
+    }
+
+    n = _hwSerial->read(buf, n < sizeof(buf) ? n : sizeof(buf));
+    size_t sent = 0;
+    while (sent < n) {
+      sent += xStreamBufferSend(_rxBuffer, buf + sent, n - sent,
+                                pdMS_TO_TICKS(10));
+      if (sent < n) {
+        // Nobody is reading; make room by dispatching if the modem is idle
+        _rxDispatchIdle();
+      }
+    }
+
+    TaskHandle_t waiter = _rxWaiter;
+    if (waiter) {
+      xTaskNotifyGive(waiter);
+    }
+    _rxDispatchIdle();
+  }
+}
+
+// Bytes that arrive while no method holds the modem can only be URCs
+void QuectelEC200U::_rxDispatchIdle() {
+  if (xSemaphoreTakeRecursive(_mutex, 0) == pdTRUE) {
+    poll();
+    xSemaphoreGiveRecursive(_mutex);
+  }
+}
+#endif
+
 void QuectelEC200U::logDebug(const String &msg) {
   if (_debugSerial) {
     _debugSerial->print(F("[DEBUG] "));
@@ -79,6 +377,7 @@ void QuectelEC200U::logError(const String &msg) {
 }
 
 bool QuectelEC200U::begin(bool forceReinit) {
+  QUECTEL_LOCK();
   // Skip initialization if already done and not forced
   if (_initialized && !forceReinit) {
     logDebug(F("Modem already initialized"));
@@ -95,6 +394,11 @@ bool QuectelEC200U::begin(bool forceReinit) {
       _hwSerial->begin(_baud);
     }
   }
+#if defined(QUECTEL_HAS_RX_NOTIFY)
+  if (_readWaitMode == ReadWaitMode::RTOS_NOTIFY) {
+    _attachRxNotify();
+  }
+#endif
 #else
   if (_hwSerial) {
     _hwSerial->begin(_baud);
@@ -219,50 +523,502 @@ void QuectelEC200U::updateNetworkStatus() {
   }
 }
 
+// ===== Command formatting =====
+ATCommand::ATCommand(const char *format, ...) {
+  va_list args;
+  va_start(args, format);
+  int n = vsnprintf(_buf, sizeof(_buf), format, args);
+  va_end(args);
+  _truncated = n < 0 || (size_t)n >= sizeof(_buf);
+  _len = _truncated ? strlen(_buf) : (size_t)n;
+}
+
+// ===== Response scanning =====
+void ATLineScanner::reset() {
+  _len = 0;
+  _line[0] = '\0';
+  _resultLine[0] = '\0';
+  _result = AT_PENDING;
+}
+
+ATResult ATLineScanner::feed(char c) {
+  if (c == '\n' || c == '\r') {
+    if (_len == 0) {
+      return AT_PENDING;
+    }
+    _line[_len] = '\0';
+    ATResult result = _classify();
+    if (result != AT_PENDING) {
+      _result = result;
+      memcpy(_resultLine, _line, _len + 1);
+    }
+    _len = 0;
+    return result;
+  }
+
+  if (_len < sizeof(_line) - 1) {
+    _line[_len++] = c;
+  }
+
+  // The data prompt is not followed by a line break
+  if (_len == 2 && _line[0] == '>' && _line[1] == ' ') {
+    _line[_len] = '\0';
+    _result = AT_PROMPT;
+    memcpy(_resultLine, _line, _len + 1);
+    _len = 0;
+    return AT_PROMPT;
+  }
+  return AT_PENDING;
+}
+
+ATResult ATLineScanner::_classify() const {
+  switch (_line[0]) {
+  case 'O':
+    if (strcmp(_line, "OK") == 0)
+      return AT_OK;
+    break;
+  case 'E':
+    if (strcmp(_line, "ERROR") == 0)
+      return AT_ERROR;
+    break;
+  case '+':
+    if (strncmp(_line, "+CME ERROR", 10) == 0)
+      return AT_CME_ERROR;
+    if (strncmp(_line, "+CMS ERROR", 10) == 0)
+      return AT_CMS_ERROR;
+    break;
+  case 'C':
+    if (strncmp(_line, "CONNECT", 7) == 0 &&
+        (_line[7] == '\0' || _line[7] == ' '))
+      return AT_CONNECT;
+    break;
+  case 'S':
+    if (strcmp(_line, "SEND OK") == 0)
+      return AT_SEND_OK;
+    if (strcmp(_line, "SEND FAIL") == 0)
+      return AT_SEND_FAIL;
+    break;
+  }
+  return AT_PENDING;
+}
+
+// ===== Field parsing =====
+static inline bool isLineEnd(char c) {
+  return c == '\0' || c == '\r' || c == '\n';
+}
+
+bool ATField::equals(const char *s) const {
+  return strlen(s) == len && strncmp(ptr, s, len) == 0;
+}
+
+long ATField::toInt() const {
+  size_t i = 0;
+  bool negative = false;
+  if (i < len && (ptr[i] == '-' || ptr[i] == '+'))
+    negative = ptr[i++] == '-';
+  long value = 0;
+  while (i < len && isDigit(ptr[i]))
+    value = value * 10 + (ptr[i++] - '0');
+  return negative ? -value : value;
+}
+
+String ATField::toString() const {
+  // reserve() + per-char append: concat(ptr, len) is not public on every core
+  String out;
+  out.reserve(len);
+  for (size_t i = 0; i < len; i++)
+    out += ptr[i];
+  return out;
+}
+
+size_t ATField::copyTo(char *buf, size_t size) const {
+  if (size == 0)
+    return 0;
+  size_t n = len < size - 1 ? len : size - 1;
+  memcpy(buf, ptr, n);
+  buf[n] = '\0';
+  return n;
+}
+
+ATTokenizer::ATTokenizer(const char *response, const char *tag)
+    : _pos(NULL), _found(false), _done(true) {
+  if (response == NULL)
+    return;
+  const char *start = response;
+  if (tag != NULL && tag[0] != '\0') {
+    start = strstr(response, tag);
+    if (start == NULL)
+      return;
+    start += strlen(tag);
+  }
+  _pos = start;
+  _found = true;
+  _done = false;
+}
+
+bool ATTokenizer::next(ATField &field) {
+  if (_done)
+    return false;
+  const char *p = _pos;
+  while (*p == ' ')
+    p++;
+
+  const char *end;
+  if (*p == '"') {
+    field.ptr = ++p;
+    while (*p != '"' && !isLineEnd(*p))
+      p++;
+    end = p;
+    if (*p == '"')
+      p++;
+    while (*p != ',' && !isLineEnd(*p))
+      p++;
+  } else {
+    field.ptr = p;
+    while (*p != ',' && !isLineEnd(*p))
+      p++;
+    end = p;
+    while (end > field.ptr && end[-1] == ' ')
+      end--;
+  }
+  field.len = end - field.ptr;
+
+  if (*p == ',')
+    _pos = p + 1;
+  else
+    _done = true;
+  return true;
+}
+
+bool ATTokenizer::field(int index, ATField &out) {
+  for (int i = 0; i < index; i++) {
+    if (!next(out))
+      return false;
+  }
+  return next(out);
+}
+
+// ===== Response sinks =====
+QuectelBufferSink::QuectelBufferSink(char *buffer, size_t size)
+    : _buffer(buffer), _size(size) {
+  clear();
+}
+
+void QuectelBufferSink::clear() {
+  _len = 0;
+  _dropped = 0;
+  if (_size > 0) {
+    _buffer[0] = '\0';
+  }
+}
+
+size_t QuectelBufferSink::write(uint8_t c) { return write(&c, 1); }
+
+size_t QuectelBufferSink::write(const uint8_t *data, size_t len) {
+  size_t room = _size > _len + 1 ? _size - _len - 1 : 0;
+  size_t n = len < room ? len : room;
+  memcpy(_buffer + _len, data, n);
+  _len += n;
+  if (_size > 0) {
+    _buffer[_len] = '\0';
+  }
+  _dropped += len - n;
+  // Report everything as consumed so readers keep draining the UART
+  return len;
+}
+
+QuectelStringSink::QuectelStringSink(String &str, size_t expected)
+    : _str(str), _reserved(str.length()) {
+  if (expected > 0) {
+    _reserved += expected;
+    _str.reserve(_reserved);
+  }
+}
+
+size_t QuectelStringSink::write(uint8_t c) { return write(&c, 1); }
+
+size_t QuectelStringSink::write(const uint8_t *data, size_t len) {
+  // Grow the reservation geometrically so appends stay O(n) overall
+  size_t needed = _str.length() + len;
+  if (needed > _reserved) {
+    size_t grow = _reserved < 64 ? 64 : _reserved * 2;
+    _reserved = needed > grow ? needed : grow;
+    _str.reserve(_reserved);
+  }
+  for (size_t i = 0; i < len; i++) {
+    _str += (char)data[i];
+  }
+  return len;
+}
+
+QuectelChunkSink::QuectelChunkSink(QuectelChunkCallback callback, void *arg)
+    : _callback(callback), _arg(arg), _len(0), _total(0) {}
+
+size_t QuectelChunkSink::write(uint8_t c) { return write(&c, 1); }
+
+size_t QuectelChunkSink::write(const uint8_t *data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    _chunk[_len++] = data[i];
+    if (_len == sizeof(_chunk)) {
+      flush();
+    }
+  }
+  _total += len;
+  return len;
+}
+
+void QuectelChunkSink::flush() {
+  if (_len > 0 && _callback) {
+    _callback(_chunk, _len, _arg);
+  }
+  _len = 0;
+}
+
+// ===== URC dispatch =====
+URCDispatcher::URCDispatcher()
+    : _count(0), _len(0), _heldLen(0), _holding(false), _lineStart(true),
+      _skipLf(false), _payload(NULL), _payloadLeft(0) {
+  _line[0] = '\0';
+}
+
+bool URCDispatcher::add(const char *prefix, QuectelUrcHandler handler,
+                        void *arg) {
+  size_t len = strlen(prefix);
+  if (len == 0 || len >= QUECTEL_URC_PREFIX_SIZE || handler == NULL) {
+    return false;
+  }
+  for (uint8_t i = 0; i < _count; i++) {
+    if (strcmp(_entries[i].prefix, prefix) == 0) {
+      _entries[i].handler = handler;
+      _entries[i].arg = arg;
+      return true;
+    }
+  }
+  if (_count >= QUECTEL_MAX_URC_HANDLERS) {
+    return false;
+  }
+  memcpy(_entries[_count].prefix, prefix, len + 1);
+  _entries[_count].handler = handler;
+  _entries[_count].arg = arg;
+  _count++;
+  return true;
+}
+
+bool URCDispatcher::remove(const char *prefix) {
+  for (uint8_t i = 0; i < _count; i++) {
+    if (strcmp(_entries[i].prefix, prefix) == 0) {
+      for (uint8_t j = i + 1; j < _count; j++) {
+        _entries[j - 1] = _entries[j];
+      }
+      _count--;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool URCDispatcher::_couldMatch() const {
+  for (uint8_t i = 0; i < _count; i++) {
+    const char *p = _entries[i].prefix;
+    size_t n = 0;
+    while (n < _len && p[n] != '\0' && p[n] == _line[n]) {
+      n++;
+    }
+    if (n == _len || p[n] == '\0') {
+      return true;
+    }
+  }
+  return false;
+}
+
+void URCDispatcher::payload(size_t length, Print *sink) {
+  _payload = sink;
+  _payloadLeft = length;
+}
+
+int URCDispatcher::_longestMatch() const {
+  int best = -1;
+  size_t bestLen = 0;
+  for (uint8_t i = 0; i < _count; i++) {
+    size_t plen = strlen(_entries[i].prefix);
+    if (plen <= _len && plen > bestLen &&
+        strncmp(_line, _entries[i].prefix, plen) == 0) {
+      best = i;
+      bestLen = plen;
+    }
+  }
+  return best;
+}
+
+URCDispatcher::Action URCDispatcher::feed(char c, const char *solicited) {
+  bool eol = (c == '\r' || c == '\n');
+  if (_skipLf) {
+    _skipLf = false;
+    if (c == '\n') {
+      return URC_DISPATCHED;
+    }
+  }
+
+  // Data announced by the URC just dispatched; never scanned for lines
+  if (_payloadLeft > 0) {
+    _payload->write((uint8_t)c);
+    if (--_payloadLeft == 0) {
+      _lineStart = true;
+    }
+    return URC_DISPATCHED;
+  }
+
+  if (!_holding) {
+    if (eol) {
+      _lineStart = true;
+      return URC_PASS;
+    }
+    if (!_lineStart || _count == 0) {
+      return URC_PASS;
+    }
+    _lineStart = false;
+    _len = 0;
+    _line[_len++] = c;
+    if (!_couldMatch()) {
+      return URC_PASS;
+    }
+    _holding = true;
+  } else if (eol) {
+    _holding = false;
+    _lineStart = true;
+    _line[_len] = '\0';
+    int match = _longestMatch();
+    if (match >= 0) {
+      _entries[match].handler(_line, _entries[match].arg);
+      _skipLf = (c == '\r');
+      return URC_DISPATCHED;
+    }
+    _line[_len] = c;
+    _heldLen = _len + 1;
+    return URC_RELEASE;
+  } else {
+    if (_len < QUECTEL_URC_LINE_SIZE) {
+      _line[_len++] = c;
+    }
+    if (!_couldMatch()) {
+      _holding = false;
+      _heldLen = _len;
+      return URC_RELEASE;
+    }
+  }
+
+  // A reply the caller asked for is handed over as soon as it is recognised
+  int match = _longestMatch();
+  if (match >= 0 && solicited != NULL &&
+      strncmp(solicited, _entries[match].prefix,
+              strlen(_entries[match].prefix)) == 0) {
+    _holding = false;
+    _heldLen = _len;
+    return URC_RELEASE;
+  }
+  return URC_HOLD;
+}
+
 // Send AT command without waiting for response (for manual handling)
-void QuectelEC200U::sendATRaw(const char *cmd) {
+bool QuectelEC200U::sendATRaw(const char *cmd) {
+  QUECTEL_LOCK();
+  if (!_commandAllowed()) {
+    return false;
+  }
   if (_debugSerial) {
     _debugSerial->print(F("CMD (Raw): "));
     _debugSerial->println(cmd);
   }
   _serial->println(cmd);
+  return true;
 }
 
-// Inspired by simple AT command approach - clean and efficient
-bool QuectelEC200U::sendAT(const char *cmd, const char *expect,
-                           uint32_t timeout) {
+bool QuectelEC200U::sendATRaw(const __FlashStringHelper *cmd) {
+  QUECTEL_LOCK();
+  if (!_commandAllowed()) {
+    return false;
+  }
   if (_debugSerial) {
-    _debugSerial->print(F("CMD: "));
+    _debugSerial->print(F("CMD (Raw): "));
     _debugSerial->println(cmd);
   }
-
   _serial->println(cmd);
+  return true;
+}
+
+bool QuectelEC200U::sendATRaw(const ATCommand &cmd) {
+  if (cmd.truncated()) {
+    logError(F("Command too long"));
+    _lastError = ErrorCode::UNKNOWN;
+    return false;
+  }
+  return sendATRaw(cmd.c_str());
+}
+
+// The UART is a data pipe to a socket; a command would go to the peer
+bool QuectelEC200U::_commandAllowed() {
+  if (_transparent) {
+    logError(F("UART is in transparent mode"));
+    _lastError = ErrorCode::TCP_ERROR;
+    return false;
+  }
+  return true;
+}
 
+// Inspired by simple AT command approach - clean and efficient
+bool QuectelEC200U::sendAT(const char *cmd, const char *expect,
+                           uint32_t timeout) {
+  QUECTEL_LOCK();
+  // Only the head of the reply is kept; the rest is still drained
   char buffer[256];
-  readResponse(buffer, sizeof(buffer), timeout);
+  QuectelBufferSink sink(buffer, sizeof(buffer));
+  bool ok = sendAT(cmd, sink, expect, timeout);
 
   if (_debugSerial) {
     _debugSerial->print(F("RESP: "));
     _debugSerial->println(buffer);
   }
+  return ok;
+}
 
-  if (strstr(buffer, expect) != NULL) {
-    _lastError = ErrorCode::NONE;
-    return true;
+bool QuectelEC200U::sendAT(const char *cmd, Print &sink, const char *expect,
+                           uint32_t timeout) {
+  QUECTEL_LOCK();
+  if (!_commandAllowed()) {
+    return false;
+  }
+  if (_debugSerial) {
+    _debugSerial->print(F("CMD: "));
+    _debugSerial->println(cmd);
   }
 
-  if (strstr(buffer, "+CME ERROR:") != NULL) {
-    _lastError = (ErrorCode)extractInteger(buffer, F("+CME ERROR:"));
-    return false;
+  _serial->println(cmd);
+
+  // Commands that open a data phase finish at CONNECT rather than OK
+  uint16_t terminators = AT_TERM_DEFAULT;
+  if (strncmp(expect, "CONNECT", 7) == 0) {
+    terminators |= AT_TERM(AT_CONNECT);
+  }
+
+  _readUntil(sink, timeout, terminators, expect);
+  return _readResult();
+}
+
+// Maps the outcome of the last read onto the return value and _lastError
+bool QuectelEC200U::_readResult() {
+  if (_expectSeen) {
+    _lastError = ErrorCode::NONE;
+    return true;
   }
 
-  if (strstr(buffer, "+CMS ERROR:") != NULL) {
-    _lastError = (ErrorCode)extractInteger(buffer, F("+CMS ERROR:"));
+  ATResult result = _scanner.result();
+  if (result == AT_CME_ERROR) {
+    _lastError = (ErrorCode)extractInteger(_scanner.resultLine(), "+CME ERROR:");
     return false;
   }
 
-  if (strstr(buffer, "ERROR") != NULL) {
-    _lastError = ErrorCode::UNKNOWN;
+  if (result == AT_CMS_ERROR) {
+    _lastError = (ErrorCode)extractInteger(_scanner.resultLine(), "+CMS ERROR:");
     return false;
   }
 
@@ -272,62 +1028,1025 @@ bool QuectelEC200U::sendAT(const char *cmd, const char *expect,
 
 bool QuectelEC200U::sendAT(const char *cmd) { return sendAT(cmd, "OK", 1000); }
 
+bool QuectelEC200U::sendAT(const ATCommand &cmd, const char *expect,
+                           uint32_t timeout) {
+  if (cmd.truncated()) {
+    logError(F("Command too long"));
+    _lastError = ErrorCode::UNKNOWN;
+    return false;
+  }
+  return sendAT(cmd.c_str(), expect, timeout);
+}
+
 bool QuectelEC200U::sendCommand(const char *cmd, const char *expected,
                                 uint32_t timeout) {
+  QUECTEL_LOCK();
   return sendAT(cmd, expected, timeout);
 }
 
+namespace {
+class NullSink : public Print {
+public:
+  size_t write(uint8_t) override { return 1; }
+  size_t write(const uint8_t *, size_t len) override { return len; }
+  using Print::write;
+};
+
+// Last occurrence of needle in buf[0, len), or NULL
+const char *findLast(const char *buf, size_t len, const char *needle) {
+  size_t n = strlen(needle);
+  for (size_t i = len; i >= n; i--) {
+    if (memcmp(buf + i - n, needle, n) == 0)
+      return buf + i - n;
+  }
+  return NULL;
+}
+
+// Locates <body> in "[CONNECT\r\n]<body>\r\nOK\r\n\r\n+QHTTPREAD: <err>" by
+// searching back from the trailer, so the body may hold any bytes. False
+// when the trailer is missing or reports an error.
+bool findHttpReadBody(const char *buf, size_t len, size_t &start,
+                      size_t &end) {
+  const char *marker = findLast(buf, len, "+QHTTPREAD:");
+  if (marker == NULL || atoi(marker + 11) != 0)
+    return false;
+  const char *ok = findLast(buf, marker - buf, "\r\nOK\r\n");
+  end = (ok != NULL ? ok : marker) - buf;
+  // Drop the CONNECT line, with or without the CRLF in front of it
+  size_t lead = end >= 2 && memcmp(buf, "\r\n", 2) == 0 ? 2 : 0;
+  if (end - lead >= 7 && memcmp(buf + lead, "CONNECT", 7) == 0) {
+    const char *nl = (const char *)memchr(buf + lead, '\n', end - lead);
+    start = nl != NULL ? nl + 1 - buf : end;
+  } else {
+    // A read that began after CONNECT's CR still has its LF in front
+    start = end > 0 && buf[0] == '\n' ? 1 : 0;
+  }
+  return true;
+}
+
+// Passes an AT+QHTTPREAD body through to `out`. The LF left over from the
+// CONNECT line is dropped and the last bytes are held back until finish()
+// can strip the "\r\nOK\r\n\r\n+QHTTPREAD: <err>" trailer.
+class HttpBodyFilter : public Print {
+public:
+  explicit HttpBodyFilter(Print &out) : _out(out), _held(0), _started(false) {}
+
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *buf, size_t len) override {
+    size_t accepted = len;
+    if (!_started && len > 0) {
+      _started = true;
+      if (buf[0] == '\n') {
+        buf++;
+        len--;
+      }
+    }
+    if (_held + len > sizeof(_tail)) {
+      size_t excess = _held + len - sizeof(_tail);
+      size_t fromTail = excess < _held ? excess : _held;
+      _out.write(_tail, fromTail);
+      memmove(_tail, _tail + fromTail, _held - fromTail);
+      _held -= fromTail;
+      _out.write(buf, excess - fromTail);
+      buf += excess - fromTail;
+      len -= excess - fromTail;
+    }
+    memcpy(_tail + _held, buf, len);
+    _held += len;
+    return accepted;
+  }
+  using Print::write;
+
+  // The "+QHTTPREAD: <err>" line has ended
+  bool complete() const {
+    const char *tail = (const char *)_tail;
+    const char *marker = findLast(tail, _held, "\r\n+QHTTPREAD:");
+    if (marker == NULL)
+      return false;
+    for (const char *p = marker + 2; p < tail + _held; p++) {
+      if (*p == '\r' || *p == '\n')
+        return true;
+    }
+    return false;
+  }
+
+  // Emits what is left of the body; true when the modem reported <err> 0
+  bool finish() {
+    const char *tail = (const char *)_tail;
+    const char *marker = findLast(tail, _held, "+QHTTPREAD:");
+    if (marker == NULL)
+      return false;
+    size_t markerAt = marker - tail;
+    const char *ok = findLast(tail, markerAt, "\r\nOK\r\n");
+    _out.write(_tail, ok != NULL ? (size_t)(ok - tail) : markerAt);
+    ATTokenizer fields(marker, "+QHTTPREAD:");
+    ATField err;
+    return fields.next(err) && err.len > 0 && err.toInt() == 0;
+  }
+
+private:
+  Print &_out;
+  uint8_t _tail[32];
+  size_t _held;
+  bool _started;
+};
+
+// Passes at most `limit` bytes on, so a body writer that runs long cannot
+// spill into the AT command stream
+class BodyLimiter : public Print {
+public:
+  BodyLimiter(Print &out, size_t limit) : _out(out), _left(limit) {}
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *data, size_t len) override {
+    if (len > _left)
+      len = _left;
+    size_t n = _out.write(data, len);
+    _left -= n;
+    return n;
+  }
+  using Print::write;
+
+private:
+  Print &_out;
+  size_t _left;
+};
+
+// QuectelBodyWriter adapters for a buffer, a Stream and a JsonDocument
+size_t writeBuffer(Print &out, size_t length, void *arg) {
+  return out.write((const uint8_t *)arg, length);
+}
+
+size_t writeStream(Print &out, size_t length, void *arg) {
+  Stream &in = *static_cast<Stream *>(arg);
+  uint8_t buf[64];
+  size_t total = 0;
+  while (total < length) {
+    size_t want = length - total < sizeof(buf) ? length - total : sizeof(buf);
+    size_t n = in.readBytes(buf, want);
+    if (n == 0 || out.write(buf, n) != n)
+      break;
+    total += n;
+  }
+  return total;
+}
+
+size_t writeJson(Print &out, size_t, void *arg) {
+  return serializeJson(*static_cast<const JsonDocument *>(arg), out);
+}
+
+// Gzips another writer's output. Compression is deterministic, so a pass
+// into a NullSink gives the length to announce.
+struct GzipBody {
+  QuectelBodyWriter writer;
+  void *arg;
+  size_t length;
+};
+
+size_t writeGzip(Print &out, size_t, void *arg) {
+  GzipBody &body = *static_cast<GzipBody *>(arg);
+  QuectelDeflater deflater(out);
+  if (body.writer(deflater, body.length, body.arg) != body.length)
+    return 0;
+  deflater.finish();
+  return deflater.compressedSize();
+}
+
+// Splits AT+QHTTPREAD output with responseheader enabled: everything up to
+// the first blank line goes to `headers`, the rest to `body`
+class HttpHeaderSplitter : public Print {
+public:
+  HttpHeaderSplitter(String &headers, Print &body)
+      : _headers(headers), _body(body), _match(0) {}
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *data, size_t len) override {
+    static const char blank[] = "\r\n\r\n";
+    size_t i = 0;
+    while (_match < 4 && i < len) {
+      char c = (char)data[i++];
+      _match = c == blank[_match] ? _match + 1 : (c == '\r' ? 1 : 0);
+      _headers += c;
+    }
+    if (_match == 4) {
+      _headers.remove(_headers.length() - 4);
+      _match = 5; // past the headers
+    }
+    if (i < len) {
+      _body.write(data + i, len - i);
+    }
+    return len;
+  }
+  using Print::write;
+
+private:
+  String &_headers;
+  Print &_body;
+  uint8_t _match;
+};
+
+// Reads AT+QHTTPREAD output with responseheader enabled: drops the header
+// block and inflates the body if Content-Encoding is gzip or deflate
+class HttpContentDecoder : public Print {
+public:
+  explicit HttpContentDecoder(Print &body)
+      : _body(body), _inflater(body), _lineLen(0), _inHeaders(true),
+        _encoded(false) {}
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *data, size_t len) override {
+    size_t i = 0;
+    while (_inHeaders && i < len) {
+      char c = (char)data[i++];
+      if (c != '\n') {
+        if (c != '\r' && _lineLen < sizeof(_line) - 1)
+          _line[_lineLen++] = c;
+        continue;
+      }
+      _line[_lineLen] = '\0';
+      if (_lineLen == 0) {
+        _inHeaders = false;
+      } else if (strncasecmp(_line, "Content-Encoding:", 17) == 0) {
+        _encoded = strstr(_line, "gzip") != NULL ||
+                   strstr(_line, "deflate") != NULL;
+      }
+      _lineLen = 0;
+    }
+    if (i < len) {
+      if (_encoded)
+        _inflater.write(data + i, len - i);
+      else
+        _body.write(data + i, len - i);
+    }
+    return len;
+  }
+  using Print::write;
+  // The body ended cleanly, checksum included when it was compressed
+  bool finish() const {
+    return !_inHeaders && (!_encoded || _inflater.finished());
+  }
+
+private:
+  Print &_body;
+  QuectelInflater _inflater;
+  char _line[40];
+  size_t _lineLen;
+  bool _inHeaders;
+  bool _encoded;
+};
+} // namespace
+
 [[deprecated("Use readResponse(char*, size_t, uint32_t) instead")]] String
 QuectelEC200U::readResponse(uint32_t timeout) {
-  char buffer[256];
-  readResponse(buffer, sizeof(buffer), timeout);
-  return String(buffer);
+  QUECTEL_LOCK();
+  String resp;
+  QuectelStringSink sink(resp);
+  _readUntil(sink, timeout, AT_TERM_DEFAULT);
+  return resp;
 }
 
 int QuectelEC200U::readResponse(char *buffer, size_t length, uint32_t timeout) {
-  size_t bytesRead = 0;
+  QUECTEL_LOCK();
+  QuectelBufferSink sink(buffer, length);
+  _readUntil(sink, timeout, AT_TERM_DEFAULT);
+  return sink.length();
+}
+
+size_t QuectelEC200U::readResponse(Print &sink, uint32_t timeout) {
+  QUECTEL_LOCK();
+  return _readUntil(sink, timeout, AT_TERM_DEFAULT);
+}
+
+// Length of the longest prefix of pattern that ends the stream after c,
+// given that the previous longest was `matched` bytes.
+static size_t advanceMatch(const char *pattern, size_t matched, char c) {
+  while (true) {
+    if (pattern[matched] == c) {
+      return matched + 1;
+    }
+    if (matched == 0) {
+      return 0;
+    }
+    // Fall back to the next shorter border of pattern[0, matched)
+    size_t k = matched - 1;
+    while (k > 0 && strncmp(pattern, pattern + matched - k, k) != 0) {
+      k--;
+    }
+    matched = k;
+  }
+}
+
+size_t QuectelEC200U::_readUntil(Print &sink, uint32_t timeout,
+                                 uint16_t terminators, const char *expect) {
+  ReadContext ctx;
+  _beginRead(ctx, sink, terminators, expect);
+  // Bytes in transparent mode are the peer's, not a reply
+  if (_transparent) {
+    _expectSeen = false;
+    return 0;
+  }
   uint32_t start = millis();
+  while (millis() - start < timeout) {
+    if (_readStep(ctx)) {
+      break;
+    }
+    uint32_t elapsed = millis() - start;
+    if (elapsed < timeout) {
+      _waitForData(timeout - elapsed);
+    }
+  }
+  // Take the final result's LF too, so the response ends in "\r\nOK\r\n"
+  // and the next command's reply does not start with it
+  if (_lfDue) {
+    if (!_serial->available()) {
+      _waitForData(QUECTEL_LF_WAIT_MS);
+    }
+    if (_serial->available() && _serial->peek() == '\n') {
+      _serial->read();
+      sink.write('\n');
+      ctx.total++;
+      _lfDue = false;
+    }
+  }
+  return ctx.total;
+}
+
+// Copies `length` bytes verbatim after a CONNECT line, skipping the LF that
+// ends it unless skipLf is false. Returns the number of payload bytes
+// delivered.
+size_t QuectelEC200U::_readRaw(Print &sink, size_t length, uint32_t timeout,
+                               bool skipLf) {
+  uint8_t buf[64];
+  size_t got = 0;
+  size_t used = 0;
+  bool first = skipLf;
+  uint32_t start = millis();
+  while (got < length && millis() - start < timeout) {
+    if (!_serial->available()) {
+      if (used > 0) {
+        sink.write(buf, used);
+        used = 0;
+      }
+      _waitForData(timeout - (millis() - start));
+      continue;
+    }
+    int c = _serial->read();
+    if (first) {
+      first = false;
+      if (c == '\n')
+        continue;
+    }
+    buf[used++] = (uint8_t)c;
+    got++;
+    if (used == sizeof(buf)) {
+      sink.write(buf, used);
+      used = 0;
+    }
+  }
+  if (used > 0)
+    sink.write(buf, used);
+  return got;
+}
+
+void QuectelEC200U::_beginRead(ReadContext &ctx, Print &sink,
+                               uint16_t terminators, const char *expect) {
+  ctx.sink = &sink;
+  ctx.expect = expect;
+  ctx.solicited = expect;
+  ctx.matched = 0;
+  ctx.total = 0;
+  ctx.raw = 0;
+  ctx.rawStart = false;
+  ctx.terminators = terminators;
+  _scanner.reset();
+  _expectSeen = false;
+  if (expect != NULL && expect[0] == '\0') {
+    _expectSeen = true;
+    ctx.expect = NULL;
+  }
+}
 
-  while (millis() - start < timeout && bytesRead < length - 1) {
-    while (_serial->available() && bytesRead < length - 1) {
-      char c = (char)_serial->read();
-      buffer[bytesRead++] = c;
-      if (_debugSerial) {
-        _debugSerial->print(c);
+// Consumes whatever the UART has buffered without waiting. Returns true once
+// a terminator selected by ctx.terminators has been read.
+bool QuectelEC200U::_readStep(ReadContext &ctx) {
+  uint8_t chunk[32];
+  size_t chunkLen = 0;
+  Print &sink = *ctx.sink;
+  bool done = false;
+
+  while (!done && _serial->available()) {
+    char c = (char)_serial->read();
+    ctx.total++;
+    if (_debugSerial) {
+      _debugSerial->print(c);
+    }
+    // The LF that ended the previous command's final result
+    if (_lfDue) {
+      _lfDue = false;
+      if (c == '\n') {
+        ctx.total--;
+        continue;
       }
     }
-    buffer[bytesRead] = '\0';
 
-    // Exit early if we have a complete response
-    if (strstr(buffer, "\r\nOK\r\n") != NULL ||
-        strstr(buffer, "\r\nERROR\r\n") != NULL ||
-        strstr(buffer, "\r\n> ") != NULL ||
-        strstr(buffer, "+CME ERROR:") != NULL) {
+    if (ctx.raw > 0) {
+      // Length-delimited payload: no URC or line handling inside it
+      bool skip = ctx.rawStart && c == '\n';
+      ctx.rawStart = false;
+      if (skip) {
+        continue;
+      }
+      if (chunkLen == sizeof(chunk)) {
+        sink.write(chunk, chunkLen);
+        chunkLen = 0;
+      }
+      chunk[chunkLen++] = (uint8_t)c;
+      ctx.raw--;
+      continue;
+    }
+
+    const char *bytes = &c;
+    size_t count = 1;
+    switch (_urc.feed(c, ctx.solicited)) {
+    case URCDispatcher::URC_PASS:
+      if (chunkLen == sizeof(chunk)) {
+        sink.write(chunk, chunkLen);
+        chunkLen = 0;
+      }
+      chunk[chunkLen++] = (uint8_t)c;
       break;
+    case URCDispatcher::URC_RELEASE:
+      if (chunkLen > 0) {
+        sink.write(chunk, chunkLen);
+        chunkLen = 0;
+      }
+      bytes = _urc.held();
+      count = _urc.heldLength();
+      sink.write((const uint8_t *)bytes, count);
+      break;
+    case URCDispatcher::URC_HOLD:
+    case URCDispatcher::URC_DISPATCHED:
+      continue;
     }
 
-    // Small delay to allow buffer to fill
-    if (!_serial->available()) {
-      delay(10);
+    for (size_t i = 0; i < count && !done; i++) {
+      if (ctx.expect != NULL) {
+        ctx.matched = advanceMatch(ctx.expect, ctx.matched, bytes[i]);
+        if (ctx.expect[ctx.matched] == '\0') {
+          _expectSeen = true;
+          ctx.expect = NULL;
+        }
+      }
+      ATResult result = _scanner.feed(bytes[i]);
+      if (result != AT_PENDING && (ctx.terminators & AT_TERM(result))) {
+        done = true;
+        // Raw data follows CONNECT and the prompt; any other result is final
+        _lfDue = bytes[i] == '\r' && result != AT_CONNECT &&
+                 result != AT_PROMPT;
+      } else if (_expectSeen && (ctx.terminators & AT_TERM_EXPECT) &&
+                 (bytes[i] == '\r' || bytes[i] == '\n')) {
+        done = true;
+      }
     }
   }
 
-  return bytesRead;
+  if (_lfDue && _serial->available() && _serial->peek() == '\n') {
+    _serial->read();
+    ctx.total++;
+    if (chunkLen == sizeof(chunk)) {
+      sink.write(chunk, chunkLen);
+      chunkLen = 0;
+    }
+    chunk[chunkLen++] = '\n';
+    _lfDue = false;
+  }
+  if (chunkLen > 0) {
+    sink.write(chunk, chunkLen);
+  }
+  return done;
 }
 
 bool QuectelEC200U::waitForResponse(const char *expect, uint32_t timeout) {
+  QUECTEL_LOCK();
   String resp = readResponse(timeout);
   return resp.indexOf(expect) != -1;
 }
 
-void QuectelEC200U::flushInput() {
-  while (_serial->available())
-    (void)_serial->read();
-}
+// Discards pending input, still dispatching any URCs in it
+void QuectelEC200U::flushInput() { poll(); }
 
 bool QuectelEC200U::expectURC(const char *tag, uint32_t timeout) {
-  String r = readResponse(timeout);
-  return r.indexOf(tag) != -1;
+  NullSink sink;
+  _readUntil(sink, timeout, AT_TERM_DEFAULT | AT_TERM_EXPECT, tag);
+  return _expectSeen;
+}
+
+bool QuectelEC200U::onURC(const char *prefix, QuectelUrcHandler handler,
+                          void *arg) {
+  QUECTEL_LOCK();
+  return _urc.add(prefix, handler, arg);
+}
+
+bool QuectelEC200U::removeURC(const char *prefix) {
+  QUECTEL_LOCK();
+  return _urc.remove(prefix);
+}
+
+void QuectelEC200U::poll() {
+  QUECTEL_LOCK();
+  // A queued command is reading; its reader dispatches URCs itself. In
+  // transparent mode the bytes belong to the socket.
+  if (_asyncActive || _transparent) {
+    return;
+  }
+  while (_serial->available()) {
+    char c = (char)_serial->read();
+    if (_debugSerial) {
+      _debugSerial->print(c);
+    }
+    _lfDue = false;
+    (void)_urc.feed(c, NULL);
+  }
+}
+
+// ===== Non-blocking operation =====
+bool QuectelEC200U::_asyncPush(uint8_t kind, const char *cmd,
+                               const char *expect, uint32_t timeout,
+                               QuectelCommandCallback callback, void *arg) {
+  if (_asyncCount >= QUECTEL_ASYNC_QUEUE_SIZE ||
+      strlen(cmd) >= QUECTEL_ASYNC_CMD_SIZE ||
+      strlen(expect) >= QUECTEL_ASYNC_EXPECT_SIZE) {
+    return false;
+  }
+  AsyncRequest &req =
+      _asyncQueue[(_asyncHead + _asyncCount) % QUECTEL_ASYNC_QUEUE_SIZE];
+  req.kind = kind;
+  strcpy(req.cmd, cmd);
+  strcpy(req.expect, expect);
+  req.timeout = timeout;
+  req.callback = callback;
+  req.arg = arg;
+  _asyncCount++;
+  return true;
+}
+
+bool QuectelEC200U::sendATAsync(const char *cmd,
+                                QuectelCommandCallback callback, void *arg,
+                                const char *expect, uint32_t timeout) {
+  QUECTEL_LOCK();
+  return _asyncPush(ASYNC_COMMAND, cmd, expect, timeout, callback, arg);
+}
+
+bool QuectelEC200U::waitForNetworkAsync(QuectelCommandCallback callback,
+                                        void *arg, uint32_t timeoutMs) {
+  QUECTEL_LOCK();
+  if (_opPending) {
+    return false;
+  }
+  _opPending = _asyncPush(ASYNC_NETWORK, "", "", timeoutMs, callback, arg);
+  return _opPending;
+}
+
+bool QuectelEC200U::attachDataAsync(const char *apn,
+                                    QuectelCommandCallback callback,
+                                    void *arg, const char *user,
+                                    const char *pass, int auth) {
+  QUECTEL_LOCK();
+  if (_opPending) {
+    return false;
+  }
+  _opPending = _asyncPush(ASYNC_ATTACH, "", "", 0, callback, arg);
+  if (_opPending) {
+    _opUrl = apn;
+    _opData = user;
+    _opPass = pass;
+    _opAuth = auth;
+  }
+  return _opPending;
+}
+
+bool QuectelEC200U::httpGetAsync(const char *url, QuectelHttpCallback callback,
+                                 void *arg, bool ssl) {
+  QUECTEL_LOCK();
+  return httpPostAsync(url, NULL, callback, arg, ssl);
+}
+
+bool QuectelEC200U::httpPostAsync(const char *url, const char *data,
+                                  QuectelHttpCallback callback, void *arg,
+                                  bool ssl) {
+  QUECTEL_LOCK();
+  if (_opPending) {
+    return false;
+  }
+  _opPending = _asyncPush(ASYNC_HTTP, "", "", 0, NULL, arg);
+  if (_opPending) {
+    _opUrl = url;
+    _opPost = data != NULL;
+    _opData = data != NULL ? data : "";
+    _opSsl = ssl;
+    _opHttpCallback = callback;
+    _httpEpoch++;
+  }
+  return _opPending;
+}
+
+void QuectelEC200U::loop() {
+  QUECTEL_LOCK();
+  if (_transparent) {
+    return;
+  }
+  if (!_asyncActive) {
+    if (_asyncCount == 0) {
+      poll();
+      return;
+    }
+    _asyncStartNext();
+    if (!_asyncActive) {
+      return;
+    }
+  }
+
+  if (_asyncReading) {
+    bool done = _readStep(_asyncCtx);
+    if (!done && millis() - _asyncStart < _asyncTimeout) {
+      return;
+    }
+    _asyncReading = false;
+    _asyncComplete(_readResult());
+  } else if (millis() - _asyncStart >= _asyncTimeout) {
+    _asyncComplete(true);
+  }
+}
+
+void QuectelEC200U::_asyncStartNext() {
+  _asyncCurrent = _asyncQueue[_asyncHead];
+  _asyncHead = (_asyncHead + 1) % QUECTEL_ASYNC_QUEUE_SIZE;
+  _asyncCount--;
+  _asyncActive = true;
+  _opStep = 0;
+
+  switch (_asyncCurrent.kind) {
+  case ASYNC_COMMAND:
+    _asyncCommand(_asyncCurrent.cmd, _asyncCurrent.expect,
+                  _asyncCurrent.timeout);
+    break;
+  case ASYNC_NETWORK:
+    _opDeadline = millis() + _asyncCurrent.timeout;
+    _networkStep(true);
+    break;
+  case ASYNC_ATTACH:
+    _attachStep(true);
+    break;
+  case ASYNC_HTTP:
+    _opBody = "";
+    _httpStep(true);
+    break;
+  }
+}
+
+void QuectelEC200U::_asyncCommand(const char *cmd, const char *expect,
+                                  uint32_t timeout, uint16_t terminators) {
+  if (_debugSerial) {
+    _debugSerial->print(F("CMD (Async): "));
+    _debugSerial->println(cmd);
+  }
+  _serial->println(cmd);
+  if (strncmp(expect, "CONNECT", 7) == 0) {
+    terminators |= AT_TERM(AT_CONNECT);
+  }
+  _asyncWait(_asyncSink, expect, timeout, terminators);
+}
+
+void QuectelEC200U::_asyncCommand(const ATCommand &cmd, const char *expect,
+                                  uint32_t timeout, uint16_t terminators) {
+  if (cmd.truncated()) {
+    logError(F("Command too long"));
+    _asyncSink.clear();
+    _asyncReading = false;
+    _asyncComplete(false);
+    return;
+  }
+  _asyncCommand(cmd.c_str(), expect, timeout, terminators);
+}
+
+void QuectelEC200U::_asyncWait(Print &sink, const char *expect,
+                               uint32_t timeout, uint16_t terminators) {
+  _asyncSink.clear();
+  _beginRead(_asyncCtx, sink, terminators, expect);
+  _asyncReading = true;
+  _asyncStart = millis();
+  _asyncTimeout = timeout;
+}
+
+void QuectelEC200U::_asyncSleep(uint32_t ms) {
+  _asyncReading = false;
+  _asyncStart = millis();
+  _asyncTimeout = ms;
+}
+
+void QuectelEC200U::_asyncComplete(bool ok) {
+  switch (_asyncCurrent.kind) {
+  case ASYNC_COMMAND:
+    _asyncActive = false;
+    if (_asyncCurrent.callback) {
+      _asyncCurrent.callback(ok, _asyncResponse, _asyncCurrent.arg);
+    }
+    break;
+  case ASYNC_NETWORK:
+    _networkStep(ok);
+    break;
+  case ASYNC_ATTACH:
+    _attachStep(ok);
+    break;
+  case ASYNC_HTTP:
+    _httpStep(ok);
+    break;
+  }
+}
+
+void QuectelEC200U::_opFinish(bool ok) {
+  _asyncActive = false;
+  _asyncReading = false;
+  _opPending = false;
+  if (_asyncCurrent.kind == ASYNC_HTTP) {
+    if (_opHttpCallback) {
+      _opHttpCallback(ok, _opBody, _asyncCurrent.arg);
+    }
+  } else if (_asyncCurrent.callback) {
+    _asyncCurrent.callback(ok, _asyncResponse, _asyncCurrent.arg);
+  }
+}
+
+// waitForNetwork(): poll AT+CREG? every 2 s until registered
+void QuectelEC200U::_networkStep(bool ok) {
+  if (_opStep == 1) {
+    int status = ok ? _parseCsvInt(_asyncResponse, "+CREG: ", 1) : -1;
+    if (status == 1 || status == 5) {
+      logDebug(F("Network registered"));
+      _opFinish(true);
+      return;
+    }
+    if ((int32_t)(millis() - _opDeadline) >= 0) {
+      logError(F("Network registration timeout"));
+      _opFinish(false);
+      return;
+    }
+    _opStep = 2;
+    _asyncSleep(2000);
+    return;
+  }
+  _opStep = 1;
+  _asyncCommand("AT+CREG?", "OK", 1000);
+}
+
+// attachData() as a state machine: CGATT, then setAPN(), then QICSGP
+void QuectelEC200U::_attachStep(bool ok) {
+  while (true) {
+    switch (_opStep) {
+    case 0:
+      logDebug(F("Attaching to data network..."));
+      _opStep = 1;
+      _asyncCommand("AT+CGATT?", "OK", 2000);
+      return;
+    case 1:
+      if (strstr(_asyncResponse, "+CGATT: 0") != NULL) {
+        logDebug(F("GPRS not attached, attaching..."));
+        _opStep = 2;
+        _asyncCommand("AT+CGATT=1", "OK", 10000);
+        return;
+      }
+      _opStep = 3;
+      continue;
+    case 2:
+      if (!ok) {
+        logError(F("GPRS attach failed"));
+        _lastError = ErrorCode::GPRS_NOT_ATTACHED;
+        _opFinish(false);
+        return;
+      }
+      _opStep = 3;
+      _asyncSleep(2000);
+      return;
+    case 3:
+      // setAPN(): deactivate active contexts first
+      _opStep = 4;
+      _asyncCommand("AT+QIACT?", "OK", 2000);
+      return;
+    case 4:
+      if (strstr(_asyncResponse, "+QIACT:") != NULL) {
+        logDebug(F("PDP contexts are active, deactivating..."));
+        _opStep = 5;
+        _asyncCommand("AT+QIDEACT=1", "OK", 40000);
+        return;
+      }
+      _opStep = 6;
+      continue;
+    case 5:
+      _opStep = 6;
+      _asyncSleep(2000);
+      return;
+    case 6:
+      _opStep = 7;
+      _asyncCommand(ATCommand("AT+CGDCONT=1,\"IP\",\"%s\"", _opUrl.c_str()),
+                    "OK", 2000);
+      return;
+    case 7:
+      if (ok) {
+        _opStep = 9;
+        continue;
+      }
+      if (strstr(_asyncResponse, "Operation not allowed") != NULL) {
+        _opStep = 8;
+        _asyncCommand("AT+CGDCONT?", "OK", 2000);
+        return;
+      }
+      logError(F("APN configuration failed"));
+      _lastError = ErrorCode::APN_CONFIG_FAILED;
+      _opFinish(false);
+      return;
+    case 8:
+      if (strstr(_asyncResponse, _opUrl.c_str()) == NULL) {
+        logError(F("APN configuration mismatch"));
+        _lastError = ErrorCode::APN_CONFIG_FAILED;
+        _opFinish(false);
+        return;
+      }
+      _opStep = 9;
+      continue;
+    case 9:
+      if (_opData.length() == 0) {
+        logDebug(F("Data attach completed successfully"));
+        _opFinish(true);
+        return;
+      }
+      _opStep = 10;
+      _asyncCommand(ATCommand("AT+QICSGP=1,1,\"%s\",\"%s\",\"%s\",%d",
+                              _opUrl.c_str(), _opData.c_str(), _opPass.c_str(),
+                              _opAuth),
+                    "OK", 2000);
+      return;
+    default:
+      if (!ok && strstr(_asyncResponse, "Operation not allowed") == NULL) {
+        logError(F("Authentication configuration failed"));
+        _lastError = ErrorCode::AUTH_CONFIG_FAILED;
+        _opFinish(false);
+        return;
+      }
+      logDebug(F("Data attach completed successfully"));
+      _opFinish(true);
+      return;
+    }
+  }
+}
+
+// _sendHttpRequest() as a state machine (without custom headers)
+void QuectelEC200U::_httpStep(bool ok) {
+  ErrorCode failure = ErrorCode::NONE;
+  while (failure == ErrorCode::NONE) {
+    switch (_opStep) {
+    case 0:
+      _opStep = 1;
+      // Left on by a request that read the response headers
+      if (_responseHeaderOn) {
+        _asyncCommand("AT+QHTTPCFG=\"responseheader\",0", "OK", 1000);
+        return;
+      }
+      continue;
+    case 1:
+      if (!ok) {
+        failure = ErrorCode::HTTP_ERROR;
+        break;
+      }
+      _responseHeaderOn = false;
+      _opStep = 2;
+      _asyncCommand("AT+QHTTPCFG=\"contextid\",1", "OK", 1000);
+      return;
+    case 2:
+      if (!ok) {
+        failure = ErrorCode::HTTP_CONTEXT_ID_FAILED;
+        break;
+      }
+      _opStep = 3;
+      if (_opSsl) {
+        _asyncCommand("AT+QHTTPCFG=\"sslctxid\",1", "OK", 1000);
+        return;
+      }
+      continue;
+    case 3:
+      if (!ok) {
+        failure = ErrorCode::HTTP_SSL_CONTEXT_ID_FAILED;
+        break;
+      }
+      _opStep = 4;
+      _asyncCommand(ATCommand("AT+QHTTPURL=%u,10", (unsigned)_opUrl.length()),
+                    "CONNECT", 1000);
+      return;
+    case 4:
+      if (!ok) {
+        failure = ErrorCode::HTTP_URL_FAILED;
+        break;
+      }
+      _writePaced((const uint8_t *)_opUrl.c_str(), _opUrl.length());
+      _opStep = 5;
+      _asyncWait(_asyncSink, "OK", 5000, AT_TERM_DEFAULT);
+      return;
+    case 5:
+      if (!ok) {
+        failure = ErrorCode::HTTP_URL_WRITE_FAILED;
+        break;
+      }
+      if (_opPost) {
+        _opStep = 6;
+        _asyncCommand(
+            ATCommand("AT+QHTTPPOST=%u,60,60", (unsigned)_opData.length()),
+            "CONNECT", 60000);
+      } else {
+        _opStep = 8;
+        _asyncCommand("AT+QHTTPGET=60", "OK", 15000);
+      }
+      return;
+    case 6:
+      if (!ok) {
+        failure = ErrorCode::HTTP_POST_FAILED;
+        break;
+      }
+      _serial->print(_opData);
+      _opStep = 7;
+      _asyncWait(_asyncSink, "OK", 10000, AT_TERM_DEFAULT);
+      return;
+    case 7:
+      if (!ok) {
+        failure = ErrorCode::HTTP_POST_DATA_WRITE_FAILED;
+        break;
+      }
+      _opStep = 9;
+      _asyncWait(_asyncSink, "+QHTTPPOST:", 20000,
+                 AT_TERM_DEFAULT | AT_TERM_EXPECT);
+      return;
+    case 8:
+      if (!ok) {
+        failure = ErrorCode::HTTP_GET_FAILED;
+        break;
+      }
+      _opStep = 9;
+      _asyncWait(_asyncSink, "+QHTTPGET:", 20000,
+                 AT_TERM_DEFAULT | AT_TERM_EXPECT);
+      return;
+    case 9: {
+      // +QHTTPGET: <err>[,<status>[,<length>]]
+      const char *tag = _opPost ? "+QHTTPPOST:" : "+QHTTPGET:";
+      ATTokenizer fields(_asyncResponse, tag);
+      ATField field;
+      if (!ok || !fields.next(field) || field.len == 0 || field.toInt() != 0) {
+        failure = _opPost ? ErrorCode::HTTP_POST_URC_FAILED
+                          : ErrorCode::HTTP_GET_URC_FAILED;
+        break;
+      }
+      _httpStatus = fields.next(field) ? (int)field.toInt() : -1;
+      _httpContentLength = fields.next(field) ? field.toInt() : -1;
+      _opStep = 10;
+      _asyncCommand("AT+QHTTPREAD=60", "CONNECT", 5000);
+      return;
+    }
+    case 10:
+      if (!ok) {
+        failure = ErrorCode::HTTP_READ_FAILED;
+        break;
+      }
+      _opBody = "";
+      _opStep = 11;
+      _asyncWait(_opBodySink, "+QHTTPREAD:", 60000,
+                 AT_TERM(AT_CME_ERROR) | AT_TERM_EXPECT);
+      if (_httpContentLength > 0) {
+        _asyncCtx.raw = _httpContentLength;
+        _asyncCtx.rawStart = true;
+      }
+      return;
+    default: {
+      size_t start, end;
+      if (!ok || !findHttpReadBody(_opBody.c_str(), _opBody.length(), start,
+                                   end)) {
+        failure = ErrorCode::HTTP_READ_FAILED;
+        break;
+      }
+      // A length from the URC means the body was read raw, LF already gone
+      if (_httpContentLength >= 0) {
+        if (_opBody.length() < (size_t)_httpContentLength + 6 ||
+            strncmp(_opBody.c_str() + _httpContentLength, "\r\nOK\r\n", 6) !=
+                0) {
+          failure = ErrorCode::HTTP_READ_FAILED;
+          break;
+        }
+        start = 0;
+        end = _httpContentLength;
+      }
+      _opBody.remove(end);
+      _opBody.remove(0, start);
+      _lastError = ErrorCode::NONE;
+      _opFinish(true);
+      return;
+    }
+    }
+  }
+  _lastError = failure;
+  _opFinish(false);
 }
 
 // Command history implementation
@@ -404,12 +2123,8 @@ String QuectelEC200U::extractQuotedString(const char *response,
   if (end == NULL)
     return "";
 
-  int length = end - (start + 1);
-  char buffer[length + 1];
-  strncpy(buffer, start + 1, length);
-  buffer[length] = '\0';
-
-  return String(buffer);
+  ATField field = {start + 1, (size_t)(end - (start + 1))};
+  return field.toString();
 }
 
 int QuectelEC200U::extractInteger(const char *response, const char *tag) {
@@ -459,95 +2174,73 @@ String QuectelEC200U::_extractFirstLine(const String &resp) const {
 }
 
 String QuectelEC200U::_collectResponse(uint32_t timeout) {
+  const uint16_t terminators = AT_TERM(AT_OK) | AT_TERM(AT_ERROR) |
+                               AT_TERM(AT_CME_ERROR) | AT_TERM(AT_CMS_ERROR);
   String resp;
-  uint32_t start = millis();
-  while (millis() - start < timeout) {
-    while (_serial->available()) {
-      char c = (char)_serial->read();
-      resp += c;
-      if (_debugSerial) {
-        _debugSerial->print(c);
-      }
-    }
-
-    if (resp.indexOf(F("\r\nOK\r\n")) != -1 ||
-        resp.indexOf(F("\r\nERROR\r\n")) != -1) {
-      break;
-    }
-
-    delay(5);
-  }
+  QuectelStringSink sink(resp);
+  _readUntil(sink, timeout, terminators);
   return resp;
 }
 
 bool QuectelEC200U::_extractHttpPayload(const String &raw, String &payload) {
-  if (raw.length() == 0) {
-    payload = "";
+  size_t start, end;
+  payload = "";
+  if (!findHttpReadBody(raw.c_str(), raw.length(), start, end)) {
     return false;
   }
-
-  if (raw.indexOf(F("ERROR")) != -1) {
-    payload = raw;
-    return false;
-  }
-
-  int marker = raw.indexOf(F("+QHTTPREAD:"));
-  if (marker == -1) {
-    payload = raw;
-    return true;
-  }
-
-  int headerEnd = raw.indexOf(F("\r\n"), marker);
-  if (headerEnd == -1) {
-    payload = raw;
-    return true;
+  payload.reserve(end - start);
+  for (size_t i = start; i < end; i++) {
+    payload += raw[i];
   }
-  int dataStart = headerEnd + 2;
-  while (dataStart < (int)raw.length() &&
-         (raw[dataStart] == '\r' || raw[dataStart] == '\n')) {
-    dataStart++;
-  }
-
-  int okIdx = raw.indexOf(F("\r\nOK"), dataStart);
-  if (okIdx == -1) {
-    okIdx = raw.length();
-  }
-
-  payload = raw.substring(dataStart, okIdx);
   return true;
 }
 
-void QuectelEC200U::_sendHttpHeaders(String headers[], size_t header_size) {
-  if (headers == nullptr || header_size == 0) {
-    return;
+bool QuectelEC200U::_sendHttpHeaders(String headers[], size_t header_size,
+                                     const char *const extra[],
+                                     size_t extra_size) {
+  if (headers == nullptr) {
+    header_size = 0;
+  }
+  if (header_size == 0 && extra_size == 0) {
+    return true;
   }
 
   logDebug(F("Sending custom HTTP headers..."));
   if (!sendAT(F("AT+QHTTPCFG=\"requestheader\",1"))) {
     logError(F("Failed to enable custom request headers."));
-    return;
+    return false;
   }
 
+  bool ok = true;
   for (size_t i = 0; i < header_size; i++) {
     String headerLine = headers[i];
     headerLine.trim();
     if (headerLine.length() > 0) {
-      String cmd = "AT+QHTTPCFG=\"header\",\"" + headerLine + "\\r\\n\"";
-      if (!sendAT(cmd)) {
+      if (!sendAT(ATCommand("AT+QHTTPCFG=\"header\",\"%s\\r\\n\"",
+                            headerLine.c_str()))) {
         logError(String(F("Failed to send header: ")) + headerLine);
+        ok = false;
       }
     }
   }
+  for (size_t i = 0; i < extra_size; i++) {
+    if (!sendAT(ATCommand("AT+QHTTPCFG=\"header\",\"%s\\r\\n\"", extra[i]))) {
+      logError(String(F("Failed to send header: ")) + extra[i]);
+      ok = false;
+    }
+  }
+  return ok;
 }
 
 // Modem info functions with better formatting
 String QuectelEC200U::getModemInfo() {
+  QUECTEL_LOCK();
   String info;
   info.reserve(256); // Pre-allocate memory
 
   info += F("=== Modem Information ===\n");
 
-  _serial->println(F("ATI"));
+  sendATRaw(F("ATI"));
   String model = readResponse(1000);
   int crIdx = model.indexOf('\r');
   if (crIdx > 0) {
@@ -588,12 +2281,14 @@ String QuectelEC200U::getModemInfo() {
 }
 
 String QuectelEC200U::getOperator() {
-  _serial->println(F("AT+COPS?"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT+COPS?"));
   String resp = readResponse(1000);
   return extractQuotedString(resp.c_str(), F("+COPS:"));
 }
 
 bool QuectelEC200U::factoryReset() {
+  QUECTEL_LOCK();
   logDebug(F("Performing factory reset..."));
   bool result = sendAT(F("AT&F"), F("OK"), 5000);
   if (result) {
@@ -607,15 +2302,18 @@ bool QuectelEC200U::factoryReset() {
 }
 
 [[deprecated("Use begin() instead")]] bool QuectelEC200U::modem_init() {
+  QUECTEL_LOCK();
   return begin();
 }
 
 bool QuectelEC200U::powerOff() {
+  QUECTEL_LOCK();
   logDebug(F("Powering off modem..."));
   return sendAT(F("AT+QPOWD=1"), F("OK"), 5000);
 }
 
 bool QuectelEC200U::reboot() {
+  QUECTEL_LOCK();
   logDebug(F("Rebooting modem..."));
   bool result = sendAT(F("AT+CFUN=1,1"), F("OK"), 5000);
   if (result) {
@@ -631,7 +2329,8 @@ bool QuectelEC200U::reboot() {
 
 // SMS utilities
 int QuectelEC200U::getSMSCount() {
-  _serial->println(F("AT+CPMS?"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT+CPMS?"));
   String resp = readResponse(1000);
 
   int start = resp.indexOf(":") + 1;
@@ -646,7 +2345,8 @@ int QuectelEC200U::getSMSCount() {
 }
 
 bool QuectelEC200U::deleteSMS(int index) {
-  return sendAT("AT+CMGD=" + String(index), "OK");
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+CMGD=%d", index), "OK");
 }
 
 // FTP utilities
@@ -654,19 +2354,24 @@ bool QuectelEC200U::ftpLogout() { return sendAT("AT+QFTPCLOSE", "OK", 10000); }
 
 // Filesystem utilities
 bool QuectelEC200U::fsExists(const char *path) {
-  _serial->println(String("AT+QFLST=\"") + path + "\"");
+  QUECTEL_LOCK();
+  if (!sendATRaw(ATCommand("AT+QFLST=\"%s\"", path))) {
+    return false;
+  }
   String resp = readResponse(1000);
   return resp.indexOf(F("+QFLST:")) != -1;
 }
 
 // MQTT utilities
 bool QuectelEC200U::mqttDisconnect() {
+  QUECTEL_LOCK();
   return sendAT("AT+QMTDISC=0", "OK", 5000);
 }
 
 // ===== Core =====
 String QuectelEC200U::getIMEI() {
-  _serial->println(F("AT+GSN"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT+GSN"));
   String resp = readResponse(1000);
   String imei = _extractFirstLine(resp);
   if (imei.length() == 0) {
@@ -681,15 +2386,18 @@ String QuectelEC200U::getIMEI() {
 }
 
 int QuectelEC200U::getSignalStrength() {
-  _serial->println(F("AT+CSQ"));
-  String resp = readResponse(1000);
-  return _parseCsvInt(resp, F("+CSQ: "), 0);
+  QUECTEL_LOCK();
+  char resp[64];
+  sendATRaw("AT+CSQ");
+  readResponse(resp, sizeof(resp), 1000);
+  return _parseCsvInt(resp, "+CSQ: ", 0);
 }
 
 bool QuectelEC200U::setAPN(const char *apn) {
+  QUECTEL_LOCK();
   // First check if PDP contexts are active and deactivate them
   flushInput();
-  _serial->println(F("AT+QIACT?"));
+  sendATRaw(F("AT+QIACT?"));
   String actResp = readResponse(2000);
 
   // If any context is active, deactivate all
@@ -701,9 +2409,9 @@ bool QuectelEC200U::setAPN(const char *apn) {
 
   // Now set the APN
   flushInput();
-  _serial->print(F("AT+CGDCONT=1,\"IP\",\""));
-  _serial->print(apn);
-  _serial->print(F("\"\r\n"));
+  if (!sendATRaw(ATCommand("AT+CGDCONT=1,\"IP\",\"%s\"", apn))) {
+    return false;
+  }
   _serial->flush();
 
   String resp = readResponse(2000);
@@ -721,7 +2429,7 @@ bool QuectelEC200U::setAPN(const char *apn) {
 
     // Query current APN settings
     flushInput();
-    _serial->println(F("AT+CGDCONT?"));
+    sendATRaw(F("AT+CGDCONT?"));
     String queryResp = readResponse(2000);
 
     // If our APN is already set, that's fine
@@ -739,6 +2447,7 @@ bool QuectelEC200U::setAPN(const char *apn) {
 
 // ===== Network + PDP =====
 bool QuectelEC200U::waitForNetwork(uint32_t timeoutMs) {
+  QUECTEL_LOCK();
   uint32_t start = millis();
   while (millis() - start < timeoutMs) {
     int status = getRegistrationStatus();
@@ -754,11 +2463,12 @@ bool QuectelEC200U::waitForNetwork(uint32_t timeoutMs) {
 
 bool QuectelEC200U::attachData(const char *apn, const char *user,
                                const char *pass, int auth) {
+  QUECTEL_LOCK();
   logDebug(F("Attaching to data network..."));
 
   // Check current GPRS attach status
   flushInput();
-  _serial->println(F("AT+CGATT?"));
+  sendATRaw(F("AT+CGATT?"));
   String attachResp = readResponse(2000);
 
   // If not attached, attach now
@@ -784,12 +2494,14 @@ bool QuectelEC200U::attachData(const char *apn, const char *user,
   // Configure authentication if provided
   if (strlen(user) > 0) {
     logDebug(F("Configuring PDP authentication..."));
-    String authCmd = String("AT+QICSGP=1,1,\"") + apn + "\",\"" + user +
-                     "\",\"" + pass + "\"," + String(auth);
+    ATCommand authCmd("AT+QICSGP=1,1,\"%s\",\"%s\",\"%s\",%d", apn, user, pass,
+                      auth);
 
     flushInput();
-    _serial->println(authCmd);
-    String authResp = readResponse(2000);
+    String authResp;
+    if (sendATRaw(authCmd)) {
+      authResp = readResponse(2000);
+    }
 
     if (authResp.indexOf(F("OK")) == -1 &&
         authResp.indexOf(F("Operation not allowed")) == -1) {
@@ -804,24 +2516,28 @@ bool QuectelEC200U::attachData(const char *apn, const char *user,
 }
 
 bool QuectelEC200U::activatePDP(int ctxId) {
-  return sendAT("AT+QIACT=" + String(ctxId), "OK", 15000);
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QIACT=%d", ctxId), "OK", 15000);
 }
 
 bool QuectelEC200U::deactivatePDP(int ctxId) {
-  return sendAT("AT+QIDEACT=" + String(ctxId), "OK", 15000);
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QIDEACT=%d", ctxId), "OK", 15000);
 }
 
 int QuectelEC200U::getRegistrationStatus(bool eps) {
-  _serial->println(eps ? F("AT+CEREG?") : F("AT+CREG?"));
-  String resp = readResponse(1000);
-  String tag = eps ? F("+CEREG: ") : F("+CREG: ");
-  return _parseCsvInt(resp, tag, 1);
+  QUECTEL_LOCK();
+  char resp[64];
+  sendATRaw(eps ? "AT+CEREG?" : "AT+CREG?");
+  readResponse(resp, sizeof(resp), 1000);
+  return _parseCsvInt(resp, eps ? "+CEREG: " : "+CREG: ", 1);
 }
 
 bool QuectelEC200U::isSimReady() { return sendAT("AT+CPIN?", "READY"); }
 
 // ===== SMS =====
 bool QuectelEC200U::sendSMS(const char *number, const char *text) {
+  QUECTEL_LOCK();
   if (!sendAT("AT+CMGF=1")) return false;
 
   // Scan for non-ASCII characters.
@@ -837,7 +2553,7 @@ bool QuectelEC200U::sendSMS(const char *number, const char *text) {
     // Plain English: use the standard GSM character set.
     sendAT(F("AT+CSCS=\"GSM\""));
     sendAT(F("AT+CSMP=17,167,0,0")); // DCS = 0 (7-bit)
-    if (!sendAT(String("AT+CMGS=\"") + number + "\"", ">", 2000)) return false;
+    if (!sendAT(ATCommand("AT+CMGS=\"%s\"", number), ">", 2000)) return false;
     _serial->print(text);
     _serial->write(26);
   } else {
@@ -848,7 +2564,7 @@ bool QuectelEC200U::sendSMS(const char *number, const char *text) {
     sendAT(F("AT+CSCS=\"UCS2\""));
     sendAT(F("AT+CSMP=17,167,0,8")); // DCS = 8 (UCS2)
 
-    if (!sendAT(String("AT+CMGS=\"") + numHex + "\"", ">", 2000)) {
+    if (!sendAT(ATCommand("AT+CMGS=\"%s\"", numHex.c_str()), ">", 2000)) {
       sendAT(F("AT+CSCS=\"GSM\"")); // Restore the configuration upon failure.
       return false;
     }
@@ -866,7 +2582,10 @@ bool QuectelEC200U::sendSMS(const char *number, const char *text) {
 }
 
 String QuectelEC200U::readSMS(int index) {
-  _serial->println("AT+CMGR=" + String(index));
+  QUECTEL_LOCK();
+  if (!sendATRaw(ATCommand("AT+CMGR=%d", index))) {
+    return "";
+  }
   String resp = readResponse(2000);
   
   String tag = F("+CMGR: ");
@@ -893,13 +2612,30 @@ String QuectelEC200U::readSMS(int index) {
 // ===== HTTP =====
 bool QuectelEC200U::httpGet(const char *url, String &response, String headers[],
                             size_t header_size) {
+  QUECTEL_LOCK();
   return _sendHttpRequest(url, "", response, headers, header_size, false,
                           false);
 }
 
+bool QuectelEC200U::httpGet(const char *url, Print &sink, String headers[],
+                            size_t header_size) {
+  QUECTEL_LOCK();
+  return _sendHttpRequest(url, "", sink, headers, header_size, false, false);
+}
+
+bool QuectelEC200U::httpGet(const char *url, QuectelChunkCallback callback,
+                            void *arg, String headers[], size_t header_size) {
+  QUECTEL_LOCK();
+  QuectelChunkSink sink(callback, arg);
+  bool ok = _sendHttpRequest(url, "", sink, headers, header_size, false, false);
+  sink.flush();
+  return ok;
+}
+
 bool QuectelEC200U::httpPost(const char *url, const char *data,
                              String &response, String headers[],
                              size_t header_size) {
+  QUECTEL_LOCK();
   return _sendHttpRequest(url, data, response, headers, header_size, false,
                           true);
 }
@@ -907,20 +2643,79 @@ bool QuectelEC200U::httpPost(const char *url, const char *data,
 bool QuectelEC200U::httpPost(const char *url, const JsonDocument &json,
                              String &response, String headers[],
                              size_t header_size) {
-  String data;
-  serializeJson(json, data);
-  return httpPost(url, data.c_str(), response, headers, header_size);
+  QUECTEL_LOCK();
+  return _postHttpBody(url, writeJson, const_cast<JsonDocument *>(&json),
+                       measureJson(json), response, headers, header_size,
+                       false);
+}
+
+bool QuectelEC200U::httpPost(const char *url, Stream &body, size_t length,
+                             String &response, String headers[],
+                             size_t header_size) {
+  QUECTEL_LOCK();
+  return _postHttpBody(url, writeStream, &body, length, response, headers,
+                       header_size, false);
+}
+
+bool QuectelEC200U::httpPost(const char *url, QuectelBodyWriter writer,
+                             void *arg, size_t length, String &response,
+                             String headers[], size_t header_size) {
+  QUECTEL_LOCK();
+  return _postHttpBody(url, writer, arg, length, response, headers,
+                       header_size, false);
+}
+
+bool QuectelEC200U::httpGet(const char *url, HttpResponse &response,
+                            bool withHeaders, String headers[],
+                            size_t header_size) {
+  QUECTEL_LOCK();
+  return _fetchHttpResponse(url, NULL, response, withHeaders, headers,
+                            header_size, false, false);
+}
+
+bool QuectelEC200U::httpPost(const char *url, const char *data,
+                             HttpResponse &response, bool withHeaders,
+                             String headers[], size_t header_size) {
+  QUECTEL_LOCK();
+  return _fetchHttpResponse(url, data, response, withHeaders, headers,
+                            header_size, false, true);
 }
 
 // ===== HTTPS =====
 bool QuectelEC200U::httpsGet(const char *url, String &response,
                              String headers[], size_t header_size) {
+  QUECTEL_LOCK();
   return _sendHttpRequest(url, "", response, headers, header_size, true, false);
 }
 
+bool QuectelEC200U::httpsGet(const char *url, Print &sink, String headers[],
+                             size_t header_size) {
+  QUECTEL_LOCK();
+  return _sendHttpRequest(url, "", sink, headers, header_size, true, false);
+}
+
+bool QuectelEC200U::httpsGet(const char *url, QuectelChunkCallback callback,
+                             void *arg, String headers[], size_t header_size) {
+  QUECTEL_LOCK();
+  QuectelChunkSink sink(callback, arg);
+  bool ok = _sendHttpRequest(url, "", sink, headers, header_size, true, false);
+  sink.flush();
+  return ok;
+}
+
+bool QuectelEC200U::httpDownload(const char *url, const char *path, bool ssl,
+                                 String headers[], size_t header_size) {
+  QUECTEL_LOCK();
+  if (!_setResponseHeader(false) ||
+      !_startHttpRequest(url, NULL, NULL, 0, headers, header_size, ssl, false))
+    return false;
+  return _finishHttpRequest(_readHttpFile(path, 120000));
+}
+
 bool QuectelEC200U::httpsPost(const char *url, const char *data,
                               String &response, String headers[],
                               size_t header_size) {
+  QUECTEL_LOCK();
   return _sendHttpRequest(url, data, response, headers, header_size, true,
                           true);
 }
@@ -928,9 +2723,42 @@ bool QuectelEC200U::httpsPost(const char *url, const char *data,
 bool QuectelEC200U::httpsPost(const char *url, const JsonDocument &json,
                               String &response, String headers[],
                               size_t header_size) {
-  String data;
-  serializeJson(json, data);
-  return httpsPost(url, data.c_str(), response, headers, header_size);
+  QUECTEL_LOCK();
+  return _postHttpBody(url, writeJson, const_cast<JsonDocument *>(&json),
+                       measureJson(json), response, headers, header_size,
+                       true);
+}
+
+bool QuectelEC200U::httpsPost(const char *url, Stream &body, size_t length,
+                              String &response, String headers[],
+                              size_t header_size) {
+  QUECTEL_LOCK();
+  return _postHttpBody(url, writeStream, &body, length, response, headers,
+                       header_size, true);
+}
+
+bool QuectelEC200U::httpsPost(const char *url, QuectelBodyWriter writer,
+                              void *arg, size_t length, String &response,
+                              String headers[], size_t header_size) {
+  QUECTEL_LOCK();
+  return _postHttpBody(url, writer, arg, length, response, headers,
+                       header_size, true);
+}
+
+bool QuectelEC200U::httpsGet(const char *url, HttpResponse &response,
+                             bool withHeaders, String headers[],
+                             size_t header_size) {
+  QUECTEL_LOCK();
+  return _fetchHttpResponse(url, NULL, response, withHeaders, headers,
+                            header_size, true, false);
+}
+
+bool QuectelEC200U::httpsPost(const char *url, const char *data,
+                              HttpResponse &response, bool withHeaders,
+                              String headers[], size_t header_size) {
+  QUECTEL_LOCK();
+  return _fetchHttpResponse(url, data, response, withHeaders, headers,
+                            header_size, true, true);
 }
 
 ErrorCode QuectelEC200U::getLastError() { return _lastError; }
@@ -992,10 +2820,133 @@ String QuectelEC200U::getLastErrorString() {
   }
 }
 
-bool QuectelEC200U::_sendHttpRequest(const String &url, const String &data,
+void QuectelEC200U::setHttpCompression(bool compressRequests,
+                                       bool acceptCompressed) {
+  QUECTEL_LOCK();
+  _httpCompressRequests = compressRequests;
+  _httpAcceptCompressed = acceptCompressed;
+}
+
+bool QuectelEC200U::_sendHttpRequest(const char *url, const char *data,
                                      String &response, String headers[],
                                      size_t header_size, bool ssl,
                                      bool isPost) {
+  response = "";
+  QuectelStringSink sink(response);
+  if (!_sendHttpRequest(url, data, sink, headers, header_size, ssl, isPost))
+    return false;
+  return response.length() > 0;
+}
+
+bool QuectelEC200U::_sendHttpRequest(const char *url, const char *data,
+                                     Print &body, String headers[],
+                                     size_t header_size, bool ssl,
+                                     bool isPost) {
+  return _exchangeHttpRequest(url, writeBuffer, (void *)data, strlen(data),
+                              body, headers, header_size, ssl, isPost);
+}
+
+bool QuectelEC200U::_postHttpBody(const char *url, QuectelBodyWriter writer,
+                                  void *arg, size_t length, String &response,
+                                  String headers[], size_t header_size,
+                                  bool ssl) {
+  response = "";
+  QuectelStringSink sink(response);
+  return _exchangeHttpRequest(url, writer, arg, length, sink, headers,
+                              header_size, ssl, true) &&
+         response.length() > 0;
+}
+
+// Request and body read for the plain String / Print variants, with the
+// compression settings applied
+bool QuectelEC200U::_exchangeHttpRequest(const char *url,
+                                         QuectelBodyWriter writer, void *arg,
+                                         size_t length, Print &body,
+                                         String headers[], size_t header_size,
+                                         bool ssl, bool isPost) {
+  // Content-Encoding is only visible with the response headers
+  if (!_setResponseHeader(_httpAcceptCompressed)) {
+    return false;
+  }
+  if (!_httpAcceptCompressed) {
+    return _startHttpRequest(url, writer, arg, length, headers, header_size,
+                             ssl, isPost, true) &&
+           _finishHttpRequest(_readHttpBody(body, 60000, _httpContentLength));
+  }
+  // The URC's length is that of the body as sent, compressed or not
+  HttpContentDecoder decoder(body);
+  return _startHttpRequest(url, writer, arg, length, headers, header_size,
+                           ssl, isPost, true) &&
+         _finishHttpRequest(
+             _readHttpBody(decoder, 60000, _httpContentLength, &decoder) &&
+             decoder.finish());
+}
+
+bool QuectelEC200U::_fetchHttpResponse(const char *url, const char *data,
+                                       HttpResponse &response,
+                                       bool withHeaders, String headers[],
+                                       size_t header_size, bool ssl,
+                                       bool isPost) {
+  response.status = -1;
+  response.contentLength = -1;
+  response.headers = "";
+  response.body = "";
+  return _setResponseHeader(withHeaders) &&
+         _startHttpRequest(url, writeBuffer, (void *)data,
+                           data ? strlen(data) : 0, headers, header_size, ssl,
+                           isPost) &&
+         _finishHttpRequest(_readHttpResponse(response, withHeaders, 60000));
+}
+
+bool QuectelEC200U::_setResponseHeader(bool on) {
+  if (_responseHeaderOn == on) {
+    return true;
+  }
+  if (!sendAT(ATCommand("AT+QHTTPCFG=\"responseheader\",%d", on ? 1 : 0))) {
+    _lastError = ErrorCode::HTTP_ERROR;
+    return false;
+  }
+  _responseHeaderOn = on;
+  return true;
+}
+
+// Fills response from the URC just parsed, then reads whatever is worth
+// reading
+bool QuectelEC200U::_readHttpResponse(HttpResponse &response,
+                                      bool withHeaders, uint32_t timeout) {
+  response.status = _httpStatus;
+  response.contentLength = _httpContentLength;
+  if (!withHeaders && (_httpContentLength == 0 || _httpStatus == 204 ||
+                       _httpStatus == 304)) {
+    return true;
+  }
+  QuectelStringSink body(response.body, _httpContentLength > 0
+                                            ? (size_t)_httpContentLength
+                                            : 0);
+  if (withHeaders) {
+    HttpHeaderSplitter split(response.headers, body);
+    return _readHttpBody(split, timeout, _httpContentLength, &split);
+  }
+  return _readHttpBody(body, timeout, _httpContentLength);
+}
+
+bool QuectelEC200U::_finishHttpRequest(bool ok) {
+  sendAT(F("AT+QHTTPCFG=\"requestheader\",0"));
+  if (!ok) {
+    _lastError = ErrorCode::HTTP_READ_FAILED;
+    return false;
+  }
+  _lastError = ErrorCode::NONE;
+  return true;
+}
+
+// Everything up to the +QHTTPGET / +QHTTPPOST URC
+bool QuectelEC200U::_startHttpRequest(const char *url,
+                                      QuectelBodyWriter writer, void *arg,
+                                      size_t length, String headers[],
+                                      size_t header_size, bool ssl,
+                                      bool isPost, bool encode) {
+  _httpEpoch++;
   if (!sendAT(F("AT+QHTTPCFG=\"contextid\",1"))) {
     _lastError = ErrorCode::HTTP_CONTEXT_ID_FAILED;
     return false;
@@ -1007,99 +2958,269 @@ bool QuectelEC200U::_sendHttpRequest(const String &url, const String &data,
     }
   }
 
-  _sendHttpHeaders(headers, header_size);
+  // Only our own writers can run twice: once to size the gzip output,
+  // once onto the UART
+  GzipBody gzip = {writer, arg, length};
+  const char *encoding[2];
+  size_t encodings = 0;
+  if (encode && _httpAcceptCompressed) {
+    encoding[encodings++] = "Accept-Encoding: gzip, deflate";
+  }
+  if (encode && isPost && _httpCompressRequests &&
+      length >= QUECTEL_GZIP_MIN_BODY &&
+      (writer == writeBuffer || writer == writeJson)) {
+    NullSink counter;
+    size_t packed = writeGzip(counter, length, &gzip);
+    if (packed > 0 && packed < length) {
+      logDebug(String(F("Gzip body: ")) + length + F(" -> ") + packed);
+      writer = writeGzip;
+      arg = &gzip;
+      length = packed;
+      encoding[encodings++] = "Content-Encoding: gzip";
+    }
+  }
+  _sendHttpHeaders(headers, header_size, encoding, encodings);
 
-  // Use a 10-second timeout for the URL
-  if (!sendAT("AT+QHTTPURL=" + String(url.length()) + ",10", F("CONNECT"))) {
+  if (!_uploadHttpUrl(url, strlen(url)) ||
+      !_issueHttpRequest(writer, arg, length, isPost) ||
+      !_awaitHttpResponse(isPost)) {
+    ErrorCode error = _lastError;
     sendAT(F("AT+QHTTPCFG=\"requestheader\",0"));
-    _lastError = ErrorCode::HTTP_URL_FAILED;
+    _lastError = error;
     return false;
   }
+  return true;
+}
 
-  // Send URL in chunks
-  int urlLength = url.length();
-  for (int i = 0; i < urlLength; i += HTTP_URL_CHUNK_SIZE) {
-    String chunk = url.substring(i, i + HTTP_URL_CHUNK_SIZE);
-    _serial->print(chunk);
-    // Small delay to allow module to process the chunk
-    delay(10);
+bool QuectelEC200U::_uploadHttpUrl(const char *url, size_t length) {
+  // Use a 10-second timeout for the URL
+  if (!sendAT(ATCommand("AT+QHTTPURL=%u,10", (unsigned)length), "CONNECT")) {
+    _lastError = ErrorCode::HTTP_URL_FAILED;
+    return false;
   }
 
-  if (!expectURC(F("OK"), 5000)) {
-    sendAT(F("AT+QHTTPCFG=\"requestheader\",0"));
+  if (_writePaced((const uint8_t *)url, length) != length ||
+      !expectURC(F("OK"), 5000)) {
     _lastError = ErrorCode::HTTP_URL_WRITE_FAILED;
     return false;
   }
+  return true;
+}
+
+// AT+QHTTPGET / AT+QHTTPPOST up to the +QHTTPGET / +QHTTPPOST URC
+bool QuectelEC200U::_submitHttpRequest(const char *data, size_t length,
+                                       bool isPost) {
+  return _issueHttpRequest(data, length, isPost) &&
+         _awaitHttpResponse(isPost);
+}
 
+bool QuectelEC200U::_issueHttpRequest(const char *data, size_t length,
+                                      bool isPost) {
+  return _issueHttpRequest(writeBuffer, (void *)data, length, isPost);
+}
+
+// Sends the request; for a POST, writer() puts the body straight on the
+// UART after CONNECT. The modem answers with a URC later.
+bool QuectelEC200U::_issueHttpRequest(QuectelBodyWriter writer, void *arg,
+                                      size_t length, bool isPost) {
   if (isPost) {
-    String cmd = "AT+QHTTPPOST=" + String(data.length()) + ",60,60";
-    if (!sendAT(cmd, F("CONNECT"))) {
-      sendAT(F("AT+QHTTPCFG=\"requestheader\",0"));
+    if (!sendAT(ATCommand("AT+QHTTPPOST=%u,60,60", (unsigned)length),
+                "CONNECT")) {
       _lastError = ErrorCode::HTTP_POST_FAILED;
       return false;
     }
-    _serial->print(data);
-    if (!expectURC(F("OK"), 10000)) {
-      sendAT(F("AT+QHTTPCFG=\"requestheader\",0"));
+    BodyLimiter out(*_serial, length);
+    if (writer(out, length, arg) != length) {
+      // The modem keeps waiting for the missing bytes until its input timeout
+      logError(F("POST body shorter than announced"));
       _lastError = ErrorCode::HTTP_POST_DATA_WRITE_FAILED;
       return false;
     }
-    if (!expectURC(F("+QHTTPPOST:"), 20000)) {
-      sendAT(F("AT+QHTTPCFG=\"requestheader\",0"));
-      _lastError = ErrorCode::HTTP_POST_URC_FAILED;
+    if (!expectURC(F("OK"), 10000)) {
+      _lastError = ErrorCode::HTTP_POST_DATA_WRITE_FAILED;
       return false;
     }
   } else {
     if (!sendAT(F("AT+QHTTPGET=60"), F("OK"), 15000)) {
-      sendAT(F("AT+QHTTPCFG=\"requestheader\",0"));
       _lastError = ErrorCode::HTTP_GET_FAILED;
       return false;
     }
-    if (!expectURC(F("+QHTTPGET:"), 20000)) {
-      sendAT(F("AT+QHTTPCFG=\"requestheader\",0"));
-      _lastError = ErrorCode::HTTP_GET_URC_FAILED;
+  }
+  return true;
+}
+
+// +QHTTPGET: <err>[,<status>[,<length>]] (same for +QHTTPPOST)
+bool QuectelEC200U::_awaitHttpResponse(bool isPost) {
+  const char *tag = isPost ? "+QHTTPPOST:" : "+QHTTPGET:";
+  char urc[64];
+  QuectelBufferSink sink(urc, sizeof(urc));
+  _readUntil(sink, 20000, AT_TERM(AT_CME_ERROR) | AT_TERM_EXPECT, tag);
+  ATTokenizer fields(urc, tag);
+  ATField field;
+  bool ok = _expectSeen && fields.next(field) && field.len > 0 &&
+            field.toInt() == 0;
+  _httpStatus = fields.next(field) ? (int)field.toInt() : -1;
+  _httpContentLength = fields.next(field) ? field.toInt() : -1;
+  if (!ok) {
+    _lastError = isPost ? ErrorCode::HTTP_POST_URC_FAILED
+                        : ErrorCode::HTTP_GET_URC_FAILED;
+  }
+  return ok;
+}
+
+// AT+QHTTPREAD: CONNECT, <body>, OK, +QHTTPREAD: <err>. The body goes to
+// `body` as it arrives. With the length from the URC exactly that many raw
+// bytes are copied, so the body may contain anything. Otherwise (chunked
+// responses) bytes are copied raw until the trailer shows up in the last
+// window, so a body containing "\r\n+QHTTPREAD:" and a line end is cut
+// there. With responseheader on, pass `headers` for the header block that
+// precedes the body.
+bool QuectelEC200U::_readHttpBody(Print &body, uint32_t timeout, long length,
+                                  Print *headers) {
+  if (!sendAT(ATCommand("AT+QHTTPREAD=%u", (unsigned)(timeout / 1000)),
+              "CONNECT", 5000))
+    return false;
+  if (length >= 0) {
+    if (headers != nullptr && !_readHttpHeaders(*headers, timeout))
       return false;
+    size_t got = _readRaw(body, (size_t)length, timeout, headers == nullptr);
+    char trailer[64];
+    QuectelBufferSink sink(trailer, sizeof(trailer));
+    _readUntil(sink, 5000, AT_TERM(AT_CME_ERROR) | AT_TERM_EXPECT,
+               "+QHTTPREAD:");
+    // A body that disagrees with the URC's length shows up as a bad trailer
+    return got == (size_t)length && _expectSeen &&
+           strncmp(trailer, "\r\nOK\r\n", 6) == 0 &&
+           _parseCsvInt(trailer, "+QHTTPREAD: ", 0) == 0;
+  }
+  // Not scanned for URCs or result codes; those would be body lines
+  HttpBodyFilter filter(body);
+  uint8_t buf[64];
+  size_t used = 0;
+  bool done = false;
+  uint32_t start = millis();
+  while (!done && millis() - start < timeout) {
+    if (!_serial->available()) {
+      if (used > 0) {
+        filter.write(buf, used);
+        used = 0;
+      }
+      _waitForData(timeout - (millis() - start));
+      continue;
+    }
+    int c = _serial->read();
+    buf[used++] = (uint8_t)c;
+    if (c == '\r' || c == '\n') {
+      filter.write(buf, used);
+      used = 0;
+      done = filter.complete();
+      // The trailer's LF is dropped by the next read
+      _lfDue = done && c == '\r';
+    } else if (used == sizeof(buf)) {
+      filter.write(buf, used);
+      used = 0;
     }
   }
+  if (used > 0)
+    filter.write(buf, used);
+  return done && filter.finish();
+}
 
-  sendAT(F("AT+QHTTPREAD"));
-  String raw = _collectResponse(30000);
-  bool ok = _extractHttpPayload(raw, response);
+// The response header block after a CONNECT line, up to and including the
+// blank line, copied straight from the UART so the body length stays exact
+bool QuectelEC200U::_readHttpHeaders(Print &sink, uint32_t timeout) {
+  static const char blank[] = "\r\n\r\n";
+  uint8_t match = 0;
+  bool first = true;
+  uint32_t start = millis();
+  while (match < 4 && millis() - start < timeout) {
+    if (!_serial->available()) {
+      _waitForData(timeout - (millis() - start));
+      continue;
+    }
+    int c = _serial->read();
+    if (first) {
+      first = false;
+      if (c == '\n')
+        continue;
+    }
+    match = c == blank[match] ? match + 1 : (c == '\r' ? 1 : 0);
+    sink.write((uint8_t)c);
+  }
+  return match == 4;
+}
 
-  sendAT(F("AT+QHTTPCFG=\"requestheader\",0"));
-  if (!ok || response.indexOf(F("ERROR")) != -1) {
-    _lastError = ErrorCode::HTTP_READ_FAILED;
+// AT+QHTTPREADFILE: OK, then +QHTTPREADFILE: <err> once the body is stored
+bool QuectelEC200U::_readHttpFile(const char *path, uint32_t timeout) {
+  if (!sendAT(ATCommand("AT+QHTTPREADFILE=\"%s\",%u", path,
+                        (unsigned)(timeout / 1000)),
+              "OK", 5000))
     return false;
-  }
-  return response.length() > 0;
+  char urc[64];
+  QuectelBufferSink sink(urc, sizeof(urc));
+  _readUntil(sink, timeout, AT_TERM(AT_CME_ERROR) | AT_TERM_EXPECT,
+             "+QHTTPREADFILE:");
+  return _expectSeen && _parseCsvInt(urc, "+QHTTPREADFILE: ", 0) == 0;
 }
 
 // ===== TCP sockets =====
 int QuectelEC200U::tcpOpen(const char *host, int port, int ctxId,
                            int socketId) {
-  String cmd = "AT+QIOPEN=" + String(ctxId) + "," + String(socketId) +
-               ",\"TCP\",\"" + host + "\"," + String(port) + ",0,1";
-  if (!sendAT(cmd, F("OK"), 5000))
+  QUECTEL_LOCK();
+  // Buffer access mode, which tcpRecv's AT+QIRD reads from
+  if (!sendAT(ATCommand("AT+QIOPEN=%d,%d,\"TCP\",\"%s\",%d,0,0", ctxId,
+                        socketId, host, port),
+              "OK", 5000))
     return -1;
-  if (!expectURC("+QIOPEN: " + String(socketId) + ",0", 15000))
+  if (!expectURC(ATCommand("+QIOPEN: %d,0", socketId), 15000))
     return -1;
   return socketId;
 }
 
 bool QuectelEC200U::tcpSend(int socketId, const char *data) {
-  String cmd = "AT+QISEND=" + String(socketId) + "," + String(strlen(data));
-  if (!sendAT(cmd, F("> "), 2000))
-    return false;
-  _serial->print(data);
+  return tcpSend(socketId, (const uint8_t *)data, strlen(data));
+}
 
-  // Wait for "SEND OK"
-  String resp = readResponse(5000);
-  return resp.indexOf(F("SEND OK")) != -1;
+bool QuectelEC200U::tcpSend(int socketId, const uint8_t *data, size_t length) {
+  QUECTEL_LOCK();
+  size_t sent = 0;
+  while (sent < length) {
+    size_t n = length - sent < QUECTEL_TCP_MAX_SEND ? length - sent
+                                                     : QUECTEL_TCP_MAX_SEND;
+    if (!_socketSend(socketId, data + sent, n)) {
+      return false;
+    }
+    sent += n;
+  }
+  return length > 0;
+}
+
+// One AT+QISEND segment: prompt, raw bytes, then SEND OK / SEND FAIL /
+// ERROR from the line scanner
+bool QuectelEC200U::_socketSend(int socketId, const uint8_t *data,
+                                size_t length) {
+  if (!sendAT(ATCommand("AT+QISEND=%d,%u", socketId, (unsigned)length), "> ",
+              2000) ||
+      _writePaced(data, length) != length) {
+    _lastError = ErrorCode::TCP_ERROR;
+    return false;
+  }
+  NullSink sink;
+  _readUntil(sink, 5000, AT_TERM_DEFAULT, "SEND OK");
+  if (!_readResult()) {
+    logError(F("TCP send not confirmed"));
+    _lastError = ErrorCode::TCP_ERROR;
+    return false;
+  }
+  return true;
 }
 
 bool QuectelEC200U::tcpRecv(int socketId, String &out, size_t bytes,
                             uint32_t timeout) {
-  _serial->println("AT+QIRD=" + String(socketId) + "," + String(bytes));
+  QUECTEL_LOCK();
+  if (!sendATRaw(ATCommand("AT+QIRD=%d,%u", socketId, (unsigned)bytes))) {
+    return false;
+  }
   String resp = readResponse(timeout);
 
   // Response is typically: +QIRD: <len>\r\n<data>
@@ -1128,12 +3249,16 @@ bool QuectelEC200U::tcpRecv(int socketId, String &out, size_t bytes,
 }
 
 bool QuectelEC200U::tcpClose(int socketId) {
-  return sendAT("AT+QICLOSE=" + String(socketId), "OK", 5000);
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QICLOSE=%d", socketId), "OK", 5000);
 }
 
 // ===== USSD =====
 bool QuectelEC200U::sendUSSD(const char *code, String &response) {
-  _serial->println(String("AT+CUSD=1,\"") + code + "\",15");
+  QUECTEL_LOCK();
+  if (!sendATRaw(ATCommand("AT+CUSD=1,\"%s\",15", code))) {
+    return false;
+  }
   String resp = readResponse(15000); // Increased timeout
 
   if (resp.indexOf(F("OK")) != -1 && resp.indexOf(F("+CUSD:")) != -1) {
@@ -1148,21 +3273,23 @@ bool QuectelEC200U::sendUSSD(const char *code, String &response) {
 // ===== NTP / Clock =====
 bool QuectelEC200U::ntpSync(const char *server, int timezone, int contextID,
                             int port) {
+  QUECTEL_LOCK();
   if (strlen(server) == 0) {
     return false;
   }
   if (timezone < -48 || timezone > 56) {
     return false;
   }
-  String cmd = "AT+QNTP=" + String(contextID) + ",\"" + server + "\"," +
-               String(port) + "," + String(timezone);
-  if (!sendAT(cmd, F("OK"), 1000))
+  if (!sendAT(ATCommand("AT+QNTP=%d,\"%s\",%d,%d", contextID, server, port,
+                        timezone),
+              "OK", 1000))
     return false;
   return expectURC(F("+QNTP: 0"), 125000);
 }
 
 String QuectelEC200U::getClock() {
-  _serial->println(F("AT+CCLK?"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT+CCLK?"));
   String resp = readResponse(1000);
   // Response is typically: +CCLK: "yy/MM/dd,HH:mm:ss±zz"
   // OK
@@ -1180,7 +3307,8 @@ String QuectelEC200U::getClock() {
 }
 
 bool QuectelEC200U::setClock(const char *datetime) {
-  return sendAT(String("AT+CCLK=\"") + datetime + "\"");
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+CCLK=\"%s\"", datetime));
 }
 
 // ===== GNSS =====
@@ -1191,11 +3319,15 @@ bool QuectelEC200U::stopGNSS() { return sendAT("AT+QGPSEND"); }
 bool QuectelEC200U::isGNSSOn() { return sendAT("AT+QGPS?", "+QGPS: 1"); }
 
 bool QuectelEC200U::setGNSSConfig(const char *item, const char *value) {
-  return sendAT(String("AT+QGPSCFG=\"") + item + "\"," + value);
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QGPSCFG=\"%s\",%s", item, value));
 }
 
 String QuectelEC200U::getNMEASentence(const char *type) {
-  _serial->println(String("AT+QGPSGNMEA=") + type);
+  QUECTEL_LOCK();
+  if (!sendATRaw(ATCommand("AT+QGPSGNMEA=%s", type))) {
+    return "";
+  }
   String resp = readResponse(1500);
   // Response is typically: +QGPSGNMEA: <nmea_sentence>
   // OK
@@ -1213,7 +3345,8 @@ String QuectelEC200U::getNMEASentence(const char *type) {
 }
 
 String QuectelEC200U::getGNSSLocation() {
-  _serial->println(F("AT+QGPSLOC=2"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT+QGPSLOC=2"));
   String resp = readResponse(2000);
   // Response is typically: +QGPSLOC: <latitude>,<longitude>,...
   // OK
@@ -1231,6 +3364,7 @@ String QuectelEC200U::getGNSSLocation() {
 }
 
 String QuectelEC200U::getGNSSLocation(uint32_t fixWaitMs) {
+  QUECTEL_LOCK();
   uint32_t start = millis();
   while (millis() - start < fixWaitMs) {
     String loc = getGNSSLocation();
@@ -1243,26 +3377,28 @@ String QuectelEC200U::getGNSSLocation(uint32_t fixWaitMs) {
 }
 
 QuectelEC200U::GNSSData QuectelEC200U::getGNSSData() {
+  QUECTEL_LOCK();
   GNSSData data;
   data.valid = false;
 
-  String raw = getGNSSLocation();
-  if (raw.length() == 0)
+  char resp[192];
+  sendATRaw("AT+QGPSLOC=2");
+  readResponse(resp, sizeof(resp), 2000);
+  ATTokenizer tokens(resp, "+QGPSLOC: ");
+  if (!tokens.found())
     return data;
 
   // Format:
   // <UTC>,<lat>,<lon>,<hdop>,<alt>,<fix>,<cog>,<spkm>,<spkn>,<date>,<nsat>
-  data.utc_time = _parseCsvString(raw, "", 0);
-  data.lat = _parseCsvString(raw, "", 1);
-  data.lon = _parseCsvString(raw, "", 2);
-  data.hdop = _parseCsvString(raw, "", 3);
-  data.altitude = _parseCsvString(raw, "", 4);
-  data.fix = _parseCsvString(raw, "", 5);
-  data.cog = _parseCsvString(raw, "", 6);
-  data.spkm = _parseCsvString(raw, "", 7);
-  data.spkn = _parseCsvString(raw, "", 8);
-  data.date = _parseCsvString(raw, "", 9);
-  data.nsat = _parseCsvString(raw, "", 10);
+  String *fields[] = {&data.utc_time, &data.lat,  &data.lon,  &data.hdop,
+                      &data.altitude, &data.fix,  &data.cog,  &data.spkm,
+                      &data.spkn,     &data.date, &data.nsat};
+  ATField field;
+  for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); i++) {
+    if (!tokens.next(field))
+      break;
+    *fields[i] = field.toString();
+  }
 
   if (data.lat.length() > 0 && data.lon.length() > 0) {
     data.valid = true;
@@ -1271,6 +3407,7 @@ QuectelEC200U::GNSSData QuectelEC200U::getGNSSData() {
 }
 
 QuectelEC200U::GNSSData QuectelEC200U::getGNSSData(uint32_t fixWaitMs) {
+  QUECTEL_LOCK();
   uint32_t start = millis();
   while (millis() - start < fixWaitMs) {
     GNSSData data = getGNSSData();
@@ -1286,20 +3423,24 @@ QuectelEC200U::GNSSData QuectelEC200U::getGNSSData(uint32_t fixWaitMs) {
 
 // ===== TTS =====
 bool QuectelEC200U::playTTS(const char *text) {
-  return sendAT(String("AT+QTTS=1,\"") + text + "\"");
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QTTS=1,\"%s\"", text));
 }
 
 // ===== FTP =====
 bool QuectelEC200U::ftpLogin(const char *server, const char *user,
                              const char *pass) {
-  if (!sendAT(String("AT+QFTPCFG=\"account\",\"") + user + "\",\"" + pass +
-              "\""))
+  QUECTEL_LOCK();
+  if (!sendAT(ATCommand("AT+QFTPCFG=\"account\",\"%s\",\"%s\"", user, pass)))
     return false;
-  return sendAT(String("AT+QFTPOPEN=\"") + server + "\",21", F("+QFTP"), 15000);
+  return sendAT(ATCommand("AT+QFTPOPEN=\"%s\",21", server), "+QFTP", 15000);
 }
 
 bool QuectelEC200U::ftpDownload(const char *filename, String &data) {
-  _serial->println(String("AT+QFTPGET=\"") + filename + "\"");
+  QUECTEL_LOCK();
+  if (!sendATRaw(ATCommand("AT+QFTPGET=\"%s\"", filename))) {
+    return false;
+  }
   String resp = readResponse(10000);
 
   // Response is typically:
@@ -1338,7 +3479,8 @@ bool QuectelEC200U::ftpDownload(const char *filename, String &data) {
 
 // ===== Filesystem =====
 bool QuectelEC200U::fsList(String &out) {
-  _serial->println(F("AT+QFLST"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT+QFLST"));
   String resp = readResponse(2000);
   // Response is typically: +QFLST: ...
   // OK
@@ -1354,88 +3496,126 @@ bool QuectelEC200U::fsList(String &out) {
 }
 
 bool QuectelEC200U::fsUpload(const char *path, const char *content) {
-  String cmd =
-      String("AT+QFUPL=\"") + path + "\"," + String(strlen(content)) + ",100";
-  if (!sendAT(cmd, F("CONNECT"), 3000))
-    return false;
-  _serial->print(content);
-
-  // Wait for "OK"
-  String resp = readResponse(5000);
-  return resp.indexOf(F("OK")) != -1;
+  return fsUpload(path, (const uint8_t *)content, strlen(content));
 }
 
-bool QuectelEC200U::fsRead(const char *path, String &out, size_t length) {
-  // Open file
-  _serial->println(String("AT+QFOPEN=\"") + path + "\",0");
-  String resp = readResponse(1000);
-  if (resp.indexOf(F("+QFOPEN:")) == -1) {
+bool QuectelEC200U::fsUpload(const char *path, const uint8_t *data,
+                             size_t length) {
+  QUECTEL_LOCK();
+  if (!sendAT(ATCommand("AT+QFUPL=\"%s\",%u,100", path, (unsigned)length),
+              "CONNECT", 3000)) {
+    _lastError = ErrorCode::FS_ERROR;
     return false;
   }
-  int handle_start = resp.indexOf(":") + 1;
-  int handle_end = resp.indexOf('\r', handle_start);
-  if (handle_end == -1) {
+  // +QFUPL: <size>,<checksum> then OK
+  if (_writePaced(data, length) != length || !expectURC(F("OK"), 5000)) {
+    _lastError = ErrorCode::FS_ERROR;
     return false;
   }
-  String handle_str = resp.substring(handle_start, handle_end);
-  handle_str.trim();
-  int handle = handle_str.toInt();
-
-  // Read file
-  _serial->println("AT+QFREAD=" + String(handle) + "," +
-                   String(length ? length : 1024));
-  String read_resp = readResponse(5000);
+  return true;
+}
 
-  // Close file
-  sendAT("AT+QFCLOSE=" + String(handle));
+bool QuectelEC200U::fsRead(const char *path, String &out, size_t length) {
+  QUECTEL_LOCK();
+  int handle = fsOpen(path);
+  if (handle < 0)
+    return false;
+  out = "";
+  QuectelStringSink sink(out);
+  int n = fsReadChunk(handle, sink, length ? length : 1024);
+  fsClose(handle);
+  return n >= 0;
+}
 
-  int content_start = read_resp.indexOf(F("CONNECT\r\n"));
-  if (content_start == -1) {
+bool QuectelEC200U::fsRead(const char *path, Print &sink, size_t chunkSize) {
+  QUECTEL_LOCK();
+  int handle = fsOpen(path);
+  if (handle < 0)
     return false;
+  int n;
+  while ((n = fsReadChunk(handle, sink, chunkSize)) > 0) {
   }
-  content_start += 9; // length of "CONNECT\r\n"
+  fsClose(handle);
+  return n == 0;
+}
 
-  int content_end = read_resp.indexOf(F("\r\nOK\r\n"), content_start);
-  if (content_end == -1) {
-    return false;
+int QuectelEC200U::fsOpen(const char *path, int mode) {
+  QUECTEL_LOCK();
+  char resp[64];
+  if (!sendATRaw(ATCommand("AT+QFOPEN=\"%s\",%d", path, mode))) {
+    return -1;
   }
+  readResponse(resp, sizeof(resp), 1000);
+  int handle = _parseCsvInt(resp, "+QFOPEN: ", 0);
+  if (strstr(resp, "+QFOPEN:") == NULL || handle < 0) {
+    _lastError = ErrorCode::FS_ERROR;
+    return -1;
+  }
+  return handle;
+}
 
-  out = read_resp.substring(content_start, content_end);
-  return true;
+// AT+QFREAD: CONNECT <n>, exactly n raw bytes, OK
+int QuectelEC200U::fsReadChunk(int handle, Print &sink, size_t length) {
+  QUECTEL_LOCK();
+  if (!sendAT(ATCommand("AT+QFREAD=%d,%u", handle, (unsigned)length),
+              "CONNECT", 5000)) {
+    _lastError = ErrorCode::FS_ERROR;
+    return -1;
+  }
+  ATTokenizer fields(_scanner.resultLine(), "CONNECT");
+  ATField field;
+  size_t expected = fields.next(field) ? field.toInt() : 0;
+  size_t got = _readRaw(sink, expected, 5000);
+  NullSink rest;
+  _readUntil(rest, 1000, AT_TERM_DEFAULT);
+  if (got != expected) {
+    _lastError = ErrorCode::FS_ERROR;
+    return -1;
+  }
+  return got;
+}
+
+bool QuectelEC200U::fsClose(int handle) {
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QFCLOSE=%d", handle));
 }
 
 bool QuectelEC200U::fsDelete(const char *path) {
-  return sendAT(String("AT+QFDEL=\"") + path + "\"");
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QFDEL=\"%s\"", path));
 }
 
 // ===== SSL/TLS =====
 bool QuectelEC200U::sslConfigure(int ctxId, const char *caPath, bool verify) {
-  if (!sendAT(String("AT+QSSLCFG=\"cacert\",") + ctxId + ",\"" + caPath + "\""))
+  QUECTEL_LOCK();
+  if (!sendAT(ATCommand("AT+QSSLCFG=\"cacert\",%d,\"%s\"", ctxId, caPath)))
     return false;
-  return sendAT(String("AT+QSSLCFG=\"seclevel\",") + ctxId + "," +
-                String(verify ? 2 : 0));
+  return sendAT(ATCommand("AT+QSSLCFG=\"seclevel\",%d,%d", ctxId, verify ? 2 : 0));
 }
 
 bool QuectelEC200U::sslUploadCert(const char *cert, const char *path) {
+  QUECTEL_LOCK();
   return fsUpload(path, cert);
 }
 
 // ===== PSM =====
 bool QuectelEC200U::enablePSM(bool enable) {
-  return sendAT(String("AT+CPSMS=") + (enable ? "1" : "0"));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+CPSMS=%d", enable ? 1 : 0));
 }
 
 // ===== MQTT =====
 bool QuectelEC200U::mqttConnect(const char *server, int port) {
-  if (!sendAT(String("AT+QMTOPEN=0,\"") + server + "\"," + String(port),
-              "+QMTOPEN: 0,0", 15000))
+  QUECTEL_LOCK();
+  if (!sendAT(ATCommand("AT+QMTOPEN=0,\"%s\",%d", server, port), "+QMTOPEN: 0,0",
+              15000))
     return false;
   return sendAT("AT+QMTCONN=0,\"ec200u\"", "+QMTCONN: 0,0", 10000);
 }
 
 bool QuectelEC200U::mqttPublish(const char *topic, const char *message) {
-  String cmd = String("AT+QMTPUB=0,0,0,0,\"") + topic + "\"";
-  if (!sendAT(cmd, F("> "), 2000))
+  QUECTEL_LOCK();
+  if (!sendAT(ATCommand("AT+QMTPUB=0,0,0,0,\"%s\"", topic), "> ", 2000))
     return false;
   _serial->print(message);
   _serial->write(26);
@@ -1446,8 +3626,9 @@ bool QuectelEC200U::mqttPublish(const char *topic, const char *message) {
 }
 
 bool QuectelEC200U::mqttSubscribe(const char *topic) {
-  return sendAT(String("AT+QMTSUB=0,1,\"") + topic + "\",0",
-                F("+QMTSUB: 0,1,0"), 5000);
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QMTSUB=0,1,\"%s\",0", topic), "+QMTSUB: 0,1,0",
+                5000);
 }
 
 String QuectelEC200U::_getSignalStrengthString(int signal) {
@@ -1482,70 +3663,28 @@ String QuectelEC200U::_getRegistrationStatusString(int regStatus) {
   }
 }
 
-int QuectelEC200U::_parseCsvInt(const String &response, const String &tag,
+int QuectelEC200U::_parseCsvInt(const char *response, const char *tag,
                                 int index) {
-  int tagIdx = response.indexOf(tag);
-  if (tagIdx == -1)
+  ATTokenizer fields(response, tag);
+  ATField field;
+  if (!fields.field(index, field))
     return -1;
-
-  int currentIdx = tagIdx + tag.length();
-  for (int i = 0; i < index; i++) {
-    currentIdx = response.indexOf(',', currentIdx);
-    if (currentIdx == -1)
-      return -1;
-    currentIdx++;
-  }
-
-  int endIdx = response.indexOf(',', currentIdx);
-  if (endIdx == -1) {
-    endIdx = response.indexOf('\r', currentIdx);
-    if (endIdx == -1) {
-      endIdx = response.length();
-    }
-  }
-
-  String valStr = response.substring(currentIdx, endIdx);
-  valStr.trim();
-  return valStr.toInt();
+  return field.toInt();
 }
 
-String QuectelEC200U::_parseCsvString(const String &response, const String &tag,
+String QuectelEC200U::_parseCsvString(const char *response, const char *tag,
                                       int index) {
-  int tagIdx = 0;
-  if (tag.length() > 0) {
-    tagIdx = response.indexOf(tag);
-    if (tagIdx == -1)
-      return "";
-    tagIdx += tag.length();
-  }
-
-  int currentIdx = tagIdx;
-  for (int i = 0; i < index; i++) {
-    currentIdx = response.indexOf(',', currentIdx);
-    if (currentIdx == -1)
-      return "";
-    currentIdx++;
-  }
-
-  int endIdx = response.indexOf(',', currentIdx);
-  if (endIdx == -1) {
-    endIdx = response.indexOf('\r', currentIdx);
-    if (endIdx == -1) {
-      endIdx = response.indexOf('\n', currentIdx);
-      if (endIdx == -1) {
-        endIdx = response.length();
-      }
-    }
-  }
-
-  String valStr = response.substring(currentIdx, endIdx);
-  valStr.trim();
-  return valStr;
+  ATTokenizer fields(response, tag);
+  ATField field;
+  if (!fields.field(index, field))
+    return "";
+  return field.toString();
 }
 
 // ===== Voice Call =====
 bool QuectelEC200U::dial(const char *number) {
-  return sendAT(String("ATD") + number + ";");
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("ATD%s;", number));
 }
 
 bool QuectelEC200U::hangup() { return sendAT("ATH"); }
@@ -1553,7 +3692,8 @@ bool QuectelEC200U::hangup() { return sendAT("ATH"); }
 bool QuectelEC200U::answer() { return sendAT("ATA"); }
 
 String QuectelEC200U::getCallList() {
-  _serial->println(F("AT+CLCC"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT+CLCC"));
   String resp = readResponse(2000);
   // Response is typically: +CLCC: ...
   // OK
@@ -1576,55 +3716,66 @@ String QuectelEC200U::getCallList() {
 }
 
 bool QuectelEC200U::enableCallerId(bool enable) {
-  return sendAT(String("AT+CLIP=") + (enable ? "1" : "0"));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+CLIP=%d", enable ? 1 : 0));
 }
 
 // ===== Audio (speaker/microphone) =====
 bool QuectelEC200U::setSpeakerVolume(int level) {
+  QUECTEL_LOCK();
   level = constrain(level, 0, 100);
-  return sendAT(String("AT+CLVL=") + level);
+  return sendAT(ATCommand("AT+CLVL=%d", level));
 }
 
 bool QuectelEC200U::setRingerVolume(int level) {
+  QUECTEL_LOCK();
   level = constrain(level, 0, 100);
-  return sendAT(String("AT+CRSL=") + level);
+  return sendAT(ATCommand("AT+CRSL=%d", level));
 }
 
 bool QuectelEC200U::setMicMute(bool mute) {
-  return sendAT(String("AT+CMUT=") + (mute ? 1 : 0));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+CMUT=%d", mute ? 1 : 0));
 }
 
 bool QuectelEC200U::setMicGain(int channel, int level) {
+  QUECTEL_LOCK();
   level = constrain(level, 0, 15);
-  return sendAT(String("AT+QMIC=") + channel + "," + level);
+  return sendAT(ATCommand("AT+QMIC=%d,%d", channel, level));
 }
 
 bool QuectelEC200U::setSidetone(bool enable, int level) {
+  QUECTEL_LOCK();
   level = constrain(level, 0, 15);
-  return sendAT(String("AT+QSIDET=") + (enable ? 1 : 0) + "," + level);
+  return sendAT(ATCommand("AT+QSIDET=%d,%d", enable ? 1 : 0, level));
 }
 
 bool QuectelEC200U::setAudioChannel(int channel) {
-  return sendAT(String("AT+QAUDCH=") + channel);
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QAUDCH=%d", channel));
 }
 
 bool QuectelEC200U::setAudioInterface(const char *params) {
-  return sendAT(String("AT+QDAI=") + params);
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QDAI=%s", params));
 }
 
 // ===== Ping =====
 bool QuectelEC200U::ping(const char *host, int contextID, int timeout,
                          int pingnum) {
+  QUECTEL_LOCK();
   String report;
   return ping(host, report, contextID, timeout, pingnum);
 }
 
 bool QuectelEC200U::ping(const char *host, String &report, int contextID,
                          int timeout, int pingnum) {
-  String cmd = String("AT+QPING=") + contextID + ",\"" + host + "\"," +
-               timeout + "," + pingnum;
+  QUECTEL_LOCK();
   flushInput();
-  _serial->println(cmd);
+  if (!sendATRaw(ATCommand("AT+QPING=%d,\"%s\",%d,%d", contextID, host,
+                           timeout, pingnum))) {
+    return false;
+  }
   String ack = readResponse(2000);
   if (ack.indexOf(F("OK")) == -1) {
     report = ack;
@@ -1654,19 +3805,19 @@ bool QuectelEC200U::ping(const char *host, String &report, int contextID,
 // ===== DNS =====
 bool QuectelEC200U::setDNS(const char *primary, const char *secondary,
                            int contextID) {
-  String cmd = String("AT+QIDNSCFG=") + contextID;
-  if (primary && strlen(primary) > 0) {
-    cmd += String(",\"") + primary + "\"";
-    if (secondary && strlen(secondary) > 0) {
-      cmd += String(",\"") + secondary + "\"";
-    }
-  }
-  return sendAT(cmd);
+  QUECTEL_LOCK();
+  if (!primary || strlen(primary) == 0)
+    return sendAT(ATCommand("AT+QIDNSCFG=%d", contextID));
+  if (!secondary || strlen(secondary) == 0)
+    return sendAT(ATCommand("AT+QIDNSCFG=%d,\"%s\"", contextID, primary));
+  return sendAT(ATCommand("AT+QIDNSCFG=%d,\"%s\",\"%s\"", contextID, primary,
+                          secondary));
 }
 
 String QuectelEC200U::getIpByHostName(const char *hostname, int contextID) {
-  String cmd = String("AT+QIDNSGIP=") + contextID + ",\"" + hostname + "\"";
-  if (!sendAT(cmd, F("OK"), 1000))
+  QUECTEL_LOCK();
+  if (!sendAT(ATCommand("AT+QIDNSGIP=%d,\"%s\"", contextID, hostname), "OK",
+              1000))
     return "";
   String resp = readResponse(60000);
   int urcIndex = resp.indexOf(F("+QIURC: \"dnsgip\""));
@@ -1695,162 +3846,125 @@ String QuectelEC200U::getIpByHostName(const char *hostname, int contextID) {
 
 // ===== ADC =====
 int QuectelEC200U::readADC() {
-  _serial->println(F("AT+QADC=0"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT+QADC=0"));
   String resp = readResponse(1000);
   return _parseCsvInt(resp, F("+QADC: "), 1);
 }
 
 // ===== Packet Domain =====
 String QuectelEC200U::getPacketDataCounter() {
-  _serial->println(F("AT+QGDCNT?"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT+QGDCNT?"));
   return readResponse(1000);
 }
 
 String QuectelEC200U::readDynamicPDNParameters(int cid) {
-  _serial->println("AT+CGCONTRDP=" + String(cid));
+  QUECTEL_LOCK();
+  if (!sendATRaw(ATCommand("AT+CGCONTRDP=%d", cid))) {
+    return "";
+  }
   return readResponse(1000);
 }
 
 QuectelEC200U::PDPContext QuectelEC200U::getPDPContext(int cid) {
+  QUECTEL_LOCK();
   PDPContext ctx;
   ctx.cid = -1; // Indicate invalid context initially
 
-  _serial->println(F("AT+CGDCONT?"));
+  sendATRaw(F("AT+CGDCONT?"));
   String resp = readResponse(1000); // Read the full response
 
-  // Look for a line starting with "+CGDCONT: <cid>"
-  String searchTag = "+CGDCONT: " + String(cid) + ",";
-  int startIndex = resp.indexOf(searchTag);
-
-  if (startIndex != -1) {
-    startIndex += searchTag.length();              // Move past the tag
-    int endIndex = resp.indexOf('\r', startIndex); // Find end of line
-    if (endIndex == -1) { // If no CR, take till end of string
-      endIndex = resp.length();
-    }
-    String line = resp.substring(startIndex, endIndex);
-
-    // Parse the line: "IP","JIONET","0.0.0.0",0,0
-    // Use a temporary char array and strtok for parsing, or careful
-    // indexOf/substring For simplicity and avoiding strtok modifying String,
-    // we'll do careful indexOf
-
-    int currentPos = 0;
-    int quoteStart, quoteEnd;
-
-    // 1. PDP_type (e.g., "IP")
-    quoteStart = line.indexOf('"', currentPos);
-    if (quoteStart != -1) {
-      quoteEnd = line.indexOf('"', quoteStart + 1);
-      if (quoteEnd != -1) {
-        ctx.pdp_type = line.substring(quoteStart + 1, quoteEnd);
-        currentPos = quoteEnd + 1; // Move past the closing quote
-      }
-    }
-
-    // Move past comma if present
-    if (line.charAt(currentPos) == ',') {
-      currentPos++;
-    }
-
-    // 2. APN (e.g., "JIONET")
-    quoteStart = line.indexOf('"', currentPos);
-    if (quoteStart != -1) {
-      quoteEnd = line.indexOf('"', quoteStart + 1);
-      if (quoteEnd != -1) {
-        ctx.apn = line.substring(quoteStart + 1, quoteEnd);
-        currentPos = quoteEnd + 1;
-      }
-    }
-
-    // Move past comma if present
-    if (line.charAt(currentPos) == ',') {
-      currentPos++;
-    }
-
-    // 3. P_ADDR (e.g., "0.0.0.0") - can be quoted or not
-    quoteStart = line.indexOf('"', currentPos);
-    if (quoteStart != -1) { // It's quoted
-      quoteEnd = line.indexOf('"', quoteStart + 1);
-      if (quoteEnd != -1) {
-        ctx.p_addr = line.substring(quoteStart + 1, quoteEnd);
-        currentPos = quoteEnd + 1;
-      }
-    } else { // It's not quoted, read until next comma or end
-      int nextComma = line.indexOf(',', currentPos);
-      if (nextComma != -1) {
-        ctx.p_addr = line.substring(currentPos, nextComma);
-        currentPos = nextComma + 1;
-      } else {
-        ctx.p_addr = line.substring(currentPos); // To end of line
-        currentPos = line.length();
-      }
-    }
-
+  // One "+CGDCONT: <cid>,"IP","JIONET","0.0.0.0",0,0" line per context
+  const char *line = resp.c_str();
+  while ((line = strstr(line, "+CGDCONT: ")) != NULL) {
+    ATTokenizer fields(line, "+CGDCONT: ");
+    line += 10;
+    ATField field;
+    if (!fields.next(field) || field.toInt() != cid)
+      continue;
+    if (fields.next(field))
+      ctx.pdp_type = field.toString();
+    if (fields.next(field))
+      ctx.apn = field.toString();
+    if (fields.next(field))
+      ctx.p_addr = field.toString();
     ctx.cid = cid; // Mark as valid
+    break;
   }
   return ctx;
 }
 
 // ===== Hardware =====
 String QuectelEC200U::getBatteryCharge() {
-  _serial->println(F("AT+CBC"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT+CBC"));
   return readResponse(1000);
 }
 
 String QuectelEC200U::getWifiScan() {
+  QUECTEL_LOCK();
   sendAT(F("AT+QWIFI=1"), F("OK"), 5000);
   flushInput();
-  _serial->println(F("AT+QWIFISCAN=8"));
+  sendATRaw(F("AT+QWIFISCAN=8"));
   return _collectResponse(30000);
 }
 
 String QuectelEC200U::scanBluetooth() {
+  QUECTEL_LOCK();
   sendAT(F("AT+QBTPWR=1"), F("OK"), 2000);
   sendAT(F("AT+QBTVIS=1,1"), F("OK"), 2000);
   flushInput();
-  _serial->println(F("AT+QBTSCAN=8"));
+  sendATRaw(F("AT+QBTSCAN=8"));
   return _collectResponse(30000);
 }
 
 // ===== Advanced TCP/IP =====
 bool QuectelEC200U::switchDataAccessMode(int connectID, int accessMode) {
-  return sendAT("AT+QISWTMD=" + String(connectID) + "," + String(accessMode),
-                (accessMode == 2 ? F("CONNECT") : F("OK")));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QISWTMD=%d,%d", connectID, accessMode),
+                accessMode == 2 ? "CONNECT" : "OK");
 }
 
 bool QuectelEC200U::echoSendData(bool enable) {
-  return sendAT(String("AT+QISDE=") + (enable ? "1" : "0"));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QISDE=%d", enable ? 1 : 0));
 }
 
 // ===== QCFG - Extended settings =====
 bool QuectelEC200U::setNetworkScanMode(int mode) {
-  return sendAT("AT+QCFG=\"nwscanmode\"," + String(mode));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QCFG=\"nwscanmode\",%d", mode));
 }
 
 bool QuectelEC200U::setBand(const char *gsm_mask, const char *lte_mask) {
-  return sendAT(String("AT+QCFG=\"band\",") + gsm_mask + "," + lte_mask);
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QCFG=\"band\",%s,%s", gsm_mask, lte_mask));
 }
 
 // ===== Modem Identification =====
 String QuectelEC200U::getManufacturerIdentification() {
-  _serial->println(F("AT+GMI"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT+GMI"));
   String resp = readResponse(1000);
   return _extractFirstLine(resp);
 }
 
 String QuectelEC200U::getModelIdentification() {
-  _serial->println(F("AT+GMM"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT+GMM"));
   return _extractFirstLine(readResponse(1000));
 }
 
 String QuectelEC200U::getFirmwareRevision() {
-  _serial->println(F("AT+GMR"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT+GMR"));
   return _extractFirstLine(readResponse(1000));
 }
 
 String QuectelEC200U::getModuleVersion() {
-  _serial->println(F("ATI"));
+  QUECTEL_LOCK();
+  sendATRaw(F("ATI"));
   String resp = readResponse(1000);
   resp.replace("\r", "\n");
   int okIdx = resp.lastIndexOf(F("\nOK"));
@@ -1866,6 +3980,7 @@ String QuectelEC200U::getModuleVersion() {
 
 // ===== General Commands =====
 bool QuectelEC200U::restoreFactoryDefaults() {
+  QUECTEL_LOCK();
   logDebug(F("Performing factory reset..."));
   bool result = sendAT(F("AT&F"), F("OK"), 5000);
   if (result) {
@@ -1879,231 +3994,281 @@ bool QuectelEC200U::restoreFactoryDefaults() {
 }
 
 String QuectelEC200U::showCurrentConfiguration() {
-  _serial->println(F("AT&V"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT&V"));
   return readResponse(2000);
 }
 
 bool QuectelEC200U::storeConfiguration(int profile) {
-  return sendAT("AT&W" + String(profile));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT&W%d", profile));
 }
 
 bool QuectelEC200U::restoreConfiguration(int profile) {
-  return sendAT("ATZ" + String(profile));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("ATZ%d", profile));
 }
 
 bool QuectelEC200U::setResultCodeEcho(bool enable) {
-  return sendAT(String("ATQ") + (enable ? "0" : "1"));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("ATQ%d", enable ? 0 : 1));
 }
 
 bool QuectelEC200U::setResultCodeFormat(bool verbose) {
-  return sendAT(String("ATV") + (verbose ? "1" : "0"));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("ATV%d", verbose ? 1 : 0));
 }
 
 bool QuectelEC200U::setCommandEcho(bool enable) {
-  return sendAT(String("ATE") + (enable ? "1" : "0"));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("ATE%d", enable ? 1 : 0));
 }
 
 bool QuectelEC200U::repeatPreviousCommand() {
-  _serial->println(F("A/"));
+  QUECTEL_LOCK();
+  sendATRaw(F("A/"));
   return expectURC(F("OK"), 3000);
 }
 
 bool QuectelEC200U::setSParameter(int s, int value) {
-  return sendAT("ATS" + String(s) + "=" + String(value));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("ATS%d=%d", s, value));
 }
 
 bool QuectelEC200U::setFunctionMode(int fun, int rst) {
-  return sendAT("AT+CFUN=" + String(fun) + "," + String(rst));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+CFUN=%d,%d", fun, rst));
 }
 
 bool QuectelEC200U::setErrorMessageFormat(int format) {
-  return sendAT("AT+CMEE=" + String(format));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+CMEE=%d", format));
 }
 
 bool QuectelEC200U::setTECharacterSet(const char *chset) {
-  return sendAT(String("AT+CSCS=\"") + chset + "\"");
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+CSCS=\"%s\"", chset));
 }
 
 bool QuectelEC200U::setURCOutputRouting(const char *port) {
-  return sendAT(String("AT+QURCCFG=\"urcport\",\"") + port + "\"");
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QURCCFG=\"urcport\",\"%s\"", port));
 }
 
 // ===== UART Control Commands =====
 bool QuectelEC200U::setDCDFunctionMode(int mode) {
-  return sendAT(String("AT&C") + mode);
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT&C%d", mode));
 }
 
 bool QuectelEC200U::setDTRFunctionMode(int mode) {
-  return sendAT(String("AT&D") + mode);
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT&D%d", mode));
 }
 
 bool QuectelEC200U::setUARTFlowControl(int dce_by_dte, int dte_by_dce) {
-  return sendAT("AT+IFC=" + String(dce_by_dte) + "," + String(dte_by_dce));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+IFC=%d,%d", dce_by_dte, dte_by_dce));
 }
 
 bool QuectelEC200U::setUARTFrameFormat(int format, int parity) {
-  return sendAT("AT+ICF=" + String(format) + "," + String(parity));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+ICF=%d,%d", format, parity));
 }
 
 bool QuectelEC200U::setUARTBaudRate(long rate) {
-  return sendAT("AT+IPR=" + String(rate));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+IPR=%ld", rate));
 }
 
 // ===== Status Control and Extended Settings =====
 String QuectelEC200U::getActivityStatus() {
-  _serial->println(F("AT+CPAS"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT+CPAS"));
   return readResponse(1000);
 }
 
 bool QuectelEC200U::setURCIndication(const char *urc_type, bool enable) {
-  return sendAT(String("AT+QINDCFG=\"") + urc_type + "\"," +
-                (enable ? "1" : "0"));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QINDCFG=\"%s\",%d", urc_type, enable ? 1 : 0));
 }
 
 // ===== (U)SIM Related Commands =====
 String QuectelEC200U::getIMSI() {
-  _serial->println(F("AT+CIMI"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT+CIMI"));
   return readResponse(1000);
 }
 
 String QuectelEC200U::getICCID() {
-  _serial->println(F("AT+QCCID"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT+QCCID"));
   return readResponse(1000);
 }
 
 String QuectelEC200U::getPinRetries() {
-  _serial->println(F("AT+QPINC"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT+QPINC"));
   return readResponse(1000);
 }
 
 // ===== Network Service Commands =====
 String QuectelEC200U::getDetailedSignalQuality() {
-  _serial->println(F("AT+QCSQ"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT+QCSQ"));
   return readResponse(1000);
 }
 
 String QuectelEC200U::getNetworkTime() {
-  _serial->println(F("AT+QLTS"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT+QLTS"));
   return readResponse(1000);
 }
 
 String QuectelEC200U::getNetworkInfo() {
-  _serial->println(F("AT+QNWINFO"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT+QNWINFO"));
   String resp = _collectResponse(2000);
   return _extractFirstLine(resp);
 }
 
 // ===== Advanced TCP/IP Configuration =====
 bool QuectelEC200U::setTCPConfig(const char *param, const char *value) {
-  return sendAT(String("AT+QICFG=\"") + param + "\"," + value);
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QICFG=\"%s\",%s", param, value));
 }
 
 String QuectelEC200U::getSocketStatus(int connectID) {
-  _serial->println("AT+QISTATE=" + String(connectID));
+  QUECTEL_LOCK();
+  if (!sendATRaw(ATCommand("AT+QISTATE=%d", connectID))) {
+    return "";
+  }
   return readResponse(1000);
 }
 
 int QuectelEC200U::getTCPError() {
-  _serial->println(F("AT+QIGETERROR"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT+QIGETERROR"));
   String resp = readResponse(1000);
   return _parseCsvInt(resp, F("+QIGETERROR: "), 0);
 }
 
 // ===== Asynchronous PDP Context =====
 bool QuectelEC200U::activatePDPAsync(int ctxId) {
-  return sendAT("AT+QIACTEX=" + String(ctxId) + ",1", F("OK"), 1000);
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QIACTEX=%d,1", ctxId), "OK", 1000);
 }
 
 bool QuectelEC200U::deactivatePDPAsync(int ctxId) {
-  return sendAT("AT+QIDEACTEX=" + String(ctxId) + ",1", F("OK"), 1000);
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QIDEACTEX=%d,1", ctxId), "OK", 1000);
 }
 
 // ===== Context Configuration =====
 bool QuectelEC200U::configureContext(int ctxId, int type, const char *apn,
                                      const char *user, const char *pass,
                                      int auth) {
-  String cmd = "AT+QICSGP=" + String(ctxId) + "," + String(type) + ",\"" + apn +
-               "\",\"" + user + "\",\"" + pass + "\"," + String(auth);
-  return sendAT(cmd);
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QICSGP=%d,%d,\"%s\",\"%s\",\"%s\",%d", ctxId,
+                          type, apn, user, pass, auth));
 }
 
 // ===== General Modem Configuration =====
 bool QuectelEC200U::setModemConfig(const char *param, const char *value) {
-  return sendAT(String("AT+QCFG=\"") + param + "\"," + value);
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QCFG=\"%s\",%s", param, value));
 }
 
 // ===== Call-Related Commands =====
 bool QuectelEC200U::setVoiceHangupControl(int mode) {
-  return sendAT("AT+CVHU=" + String(mode));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+CVHU=%d", mode));
 }
 
 bool QuectelEC200U::hangupVoiceCall() { return sendAT("AT+CHUP"); }
 
 bool QuectelEC200U::setConnectionTimeout(int seconds) {
-  return sendAT("ATS7=" + String(seconds));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("ATS7=%d", seconds));
 }
 
 // ===== Phonebook Commands =====
 String QuectelEC200U::getSubscriberNumber() {
-  _serial->println(F("AT+CNUM"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT+CNUM"));
   return readResponse(1000);
 }
 
 String QuectelEC200U::findPhonebookEntries(const char *findtext) {
-  _serial->println(String("AT+CPBF=\"") + findtext + "\"");
+  QUECTEL_LOCK();
+  if (!sendATRaw(ATCommand("AT+CPBF=\"%s\"", findtext))) {
+    return "";
+  }
   return readResponse(5000);
 }
 
 String QuectelEC200U::readPhonebookEntry(int index1, int index2) {
-  String cmd = "AT+CPBR=" + String(index1);
-  if (index2 != -1) {
-    cmd += "," + String(index2);
+  QUECTEL_LOCK();
+  bool sent = index2 != -1
+                  ? sendATRaw(ATCommand("AT+CPBR=%d,%d", index1, index2))
+                  : sendATRaw(ATCommand("AT+CPBR=%d", index1));
+  if (!sent) {
+    return "";
   }
-  _serial->println(cmd);
   return readResponse(5000);
 }
 
 bool QuectelEC200U::selectPhonebookStorage(const char *storage) {
-  return sendAT(String("AT+CPBS=\"") + storage + "\"");
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+CPBS=\"%s\"", storage));
 }
 
 bool QuectelEC200U::writePhonebookEntry(int index, const char *number,
                                         const char *text, int type) {
-  return sendAT(String("AT+CPBW=") + index + ",\"" + number + "\"," + type +
-                ",\"" + text + "\"");
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+CPBW=%d,\"%s\",%d,\"%s\"", index, number, type,
+                          text));
 }
 
 // ===== SMS Commands =====
 bool QuectelEC200U::setMessageFormat(int mode) {
-  return sendAT("AT+CMGF=" + String(mode));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+CMGF=%d", mode));
 }
 
 bool QuectelEC200U::setServiceCenterAddress(const char *sca) {
-  return sendAT(String("AT+CSCA=\"") + sca + "\"");
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+CSCA=\"%s\"", sca));
 }
 
 String QuectelEC200U::listMessages(const char *stat) {
-  _serial->println(String("AT+CMGL=\"") + stat + "\"");
+  QUECTEL_LOCK();
+  if (!sendATRaw(ATCommand("AT+CMGL=\"%s\"", stat))) {
+    return "";
+  }
   return readResponse(10000);
 }
 
 bool QuectelEC200U::setNewMessageIndication(int mode, int mt, int bm, int ds,
                                             int bfr) {
-  return sendAT("AT+CNMI=" + String(mode) + "," + String(mt) + "," +
-                String(bm) + "," + String(ds) + "," + String(bfr));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+CNMI=%d,%d,%d,%d,%d", mode, mt, bm, ds, bfr));
 }
 
 // ===== Packet Domain Commands =====
 bool QuectelEC200U::gprsAttach(bool attach) {
-  return sendAT("AT+CGATT=" + String(attach ? 1 : 0));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+CGATT=%d", attach ? 1 : 0));
 }
 
 bool QuectelEC200U::setGPRSClass(const char *gprs_class) {
-  return sendAT(String("AT+CGCLASS=\"") + gprs_class + "\"");
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+CGCLASS=\"%s\"", gprs_class));
 }
 
 bool QuectelEC200U::setPacketDomainEventReporting(int mode) {
-  return sendAT("AT+CGEREP=" + String(mode));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+CGEREP=%d", mode));
 }
 
 // Hardware
@@ -2111,55 +4276,66 @@ bool QuectelEC200U::setPacketDomainEventReporting(int mode) {
 // ===== Supplementary Service Commands =====
 bool QuectelEC200U::setCallForwarding(int reason, int mode, const char *number,
                                       int time) {
-  return sendAT(String("AT+CCFC=") + reason + "," + mode + ",\"" + number +
-                "\"," + time);
+  QUECTEL_LOCK();
+  return sendAT(
+      ATCommand("AT+CCFC=%d,%d,\"%s\",%d", reason, mode, number, time));
 }
 
 bool QuectelEC200U::setCallWaiting(int mode) {
-  return sendAT("AT+CCWA=" + String(mode));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+CCWA=%d", mode));
 }
 
 bool QuectelEC200U::setCallingLineIdentificationPresentation(bool enable) {
-  return sendAT("AT+CLIP=" + String(enable ? 1 : 0));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+CLIP=%d", enable ? 1 : 0));
 }
 
 bool QuectelEC200U::setCallingLineIdentificationRestriction(int mode) {
-  return sendAT("AT+CLIR=" + String(mode));
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+CLIR=%d", mode));
 }
 
 // ===== More Audio Commands =====
 bool QuectelEC200U::recordAudio(const char *filename) {
-  return sendAT(String("AT+QAUDRD=\"") + filename + "\"");
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QAUDRD=\"%s\"", filename));
 }
 
 bool QuectelEC200U::playAudio(const char *filename) {
-  return sendAT(String("AT+QAUDPLAY=\"") + filename + "\"");
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QAUDPLAY=\"%s\"", filename));
 }
 
 bool QuectelEC200U::stopAudio() { return sendAT("AT+QAUDSTOP"); }
 
 bool QuectelEC200U::playTextToSpeech(const char *text) {
-  return sendAT(String("AT+QTTS=1,\"") + text + "\"");
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QTTS=1,\"%s\"", text));
 }
 
 // ===== Remaining TCP/IP Commands =====
 bool QuectelEC200U::sendHexData(int connectID, const char *hex_string) {
-  return sendAT(String("AT+QISENDEX=") + connectID + ",\"" + hex_string + "\"");
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QISENDEX=%d,\"%s\"", connectID, hex_string));
 }
 
 // ===== Advanced Error Reporting and SIM =====
 String QuectelEC200U::getExtendedErrorReports() {
-  _serial->println(F("AT+CEER"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT+CEER"));
   return readResponse(2000);
 }
 
 String QuectelEC200U::getSIMStatus() {
-  _serial->println(F("AT+CPIN?"));
+  QUECTEL_LOCK();
+  sendATRaw(F("AT+CPIN?"));
   return readResponse(1000);
 }
 
 // Power Management
 void QuectelEC200U::powerOn(int pin) {
+  QUECTEL_LOCK();
   pinMode(pin, OUTPUT);
   // EC200U requires PWRKEY to be held LOW for at least 2 seconds to power on
   digitalWrite(pin, LOW);
@@ -2176,18 +4352,17 @@ void QuectelEC200U::powerOn(int pin) {
 bool QuectelEC200U::switchSimCard() { return sendAT(F("AT+QSIMCHK")); }
 
 bool QuectelEC200U::toggleISIM(bool enable) {
-  String cmd = F("AT+QIMSCFG=\"isim\",");
-  cmd += enable ? "1" : "0";
-  return sendAT(cmd);
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QIMSCFG=\"isim\",%d", enable ? 1 : 0));
 }
 
 bool QuectelEC200U::setDSDSMode(bool dsds) {
-  String cmd = F("AT+QDSTYPE=");
-  cmd += dsds ? "1" : "0";
-  return sendAT(cmd);
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QDSTYPE=%d", dsds ? 1 : 0));
 }
 
 String QuectelEC200U::getOperatorName() {
+  QUECTEL_LOCK();
   sendATRaw(F("AT+QSPN"));
   char buffer[256];
   readResponse(buffer, sizeof(buffer), 2000);
@@ -2195,48 +4370,42 @@ String QuectelEC200U::getOperatorName() {
 }
 
 bool QuectelEC200U::preventNetworkModeSwitch(bool enable) {
-  String cmd = F("AT+QCFG=\"cops_no_mode_change\",");
-  cmd += enable ? "1" : "0";
-  return sendAT(cmd);
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QCFG=\"cops_no_mode_change\",%d", enable ? 1 : 0));
 }
 
 // [B] Audio & Voice
 bool QuectelEC200U::blockIncomingCalls(bool enable) {
-  String cmd = F("AT+QREFUSECS=");
-  cmd += enable ? "1" : "0";
-  return sendAT(cmd);
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QREFUSECS=%d", enable ? 1 : 0));
 }
 
 bool QuectelEC200U::playAudioDuringCall(const char *filename) {
-  String cmd = F("AT+QAUDPLAY=\"");
-  cmd += filename;
-  cmd += "\"";
-  return sendAT(cmd);
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QAUDPLAY=\"%s\"", filename));
 }
 
 bool QuectelEC200U::configureAudioCodecIIC(int mode) {
-  String cmd = F("AT+QAUDCFG=\"iic\",");
-  cmd += mode;
-  return sendAT(cmd);
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QAUDCFG=\"iic\",%d", mode));
 }
 
 // [C] Data & TCP/IP
 bool QuectelEC200U::setTCPMSS(int mss) {
-  String cmd = F("AT+QCFG=\"tcp/mss\",");
-  cmd += mss;
-  return sendAT(cmd);
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QCFG=\"tcp/mss\",%d", mss));
 }
 
 bool QuectelEC200U::setBIPStatusURC(bool enable) {
-  String cmd = F("AT+QCFG=\"bip/status\",");
-  cmd += enable ? "1" : "0";
-  return sendAT(cmd);
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QCFG=\"bip/status\",%d", enable ? 1 : 0));
 }
 
 // [D] System & Hardware
 bool QuectelEC200U::setUSBModeCDC() { return sendAT(F("AT+QUSBCFG=3,1")); }
 
 bool QuectelEC200U::configureRIAuto(bool enable) {
+  QUECTEL_LOCK();
   if (enable)
     return sendAT(F("AT+QCFG=\"urc/ri/ring\",\"auto\""));
   else
@@ -2244,9 +4413,8 @@ bool QuectelEC200U::configureRIAuto(bool enable) {
 }
 
 bool QuectelEC200U::configureGNSSURC(bool enable) {
-  String cmd = F("AT+QGPSCFG=\"urc\",");
-  cmd += enable ? "1" : "0";
-  return sendAT(cmd);
+  QUECTEL_LOCK();
+  return sendAT(ATCommand("AT+QGPSCFG=\"urc\",%d", enable ? 1 : 0));
 }
 
 // ===== SMS character set conversion helper function =====
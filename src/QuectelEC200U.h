@@ -43,7 +43,38 @@
 // Command history for Ctrl+Z functionality
 #define MAX_HISTORY 20
 #define MAX_CMD_LENGTH 256
-#define HTTP_URL_CHUNK_SIZE 2048
+
+// Largest payload AT+QISEND accepts in one go
+#ifndef QUECTEL_TCP_MAX_SEND
+#define QUECTEL_TCP_MAX_SEND 1460
+#endif
+
+// Upper bound on a single wait between UART polls (see setReadWaitMode)
+#define QUECTEL_READ_POLL_INTERVAL_MS 10
+
+// ESP32 cores with HardwareSerial::onReceive() can wake readers on RX events
+#if defined(ARDUINO_ARCH_ESP32) && defined(ESP_ARDUINO_VERSION_MAJOR)
+#if ESP_ARDUINO_VERSION_MAJOR >= 2
+#define QUECTEL_HAS_RX_NOTIFY
+#endif
+#endif
+
+// ESP32 worker-task mode (see startWorker)
+#if defined(ARDUINO_ARCH_ESP32)
+#define QUECTEL_HAS_WORKER
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <freertos/stream_buffer.h>
+#ifndef QUECTEL_WORKER_RX_BUFFER_SIZE
+#define QUECTEL_WORKER_RX_BUFFER_SIZE 4096
+#endif
+#ifndef QUECTEL_WORKER_STACK_SIZE
+#define QUECTEL_WORKER_STACK_SIZE 3072
+#endif
+#ifndef QUECTEL_WORKER_PRIORITY
+#define QUECTEL_WORKER_PRIORITY 5
+#endif
+#endif
 
 // Modem states
 enum ModemState {
@@ -83,7 +114,296 @@ enum class ErrorCode {
   FS_ERROR = -70,
 };
 
+// printf-style command formatted into a stack buffer of MAX_CMD_LENGTH
+// bytes, so building a command never touches the heap:
+//   sendAT(ATCommand("AT+QIACT=%d", ctxId), "OK", 15000);
+class ATCommand {
+  public:
+    explicit ATCommand(const char *format, ...)
+        __attribute__((format(printf, 2, 3)));
+    operator const char *() const { return _buf; }
+    const char *c_str() const { return _buf; }
+    size_t length() const { return _len; }
+    // The formatted command did not fit and must not be sent
+    bool truncated() const { return _truncated; }
+
+  private:
+    char _buf[MAX_CMD_LENGTH];
+    size_t _len;
+    bool _truncated;
+};
+
+// Longest line prefix the response scanner keeps (longer lines are still
+// classified, only their tail is dropped)
+#ifndef QUECTEL_LINE_BUFFER_SIZE
+#define QUECTEL_LINE_BUFFER_SIZE 64
+#endif
+
+// How long a reader that stopped on a final result's CR waits for its LF
+#ifndef QUECTEL_LF_WAIT_MS
+#define QUECTEL_LF_WAIT_MS 10
+#endif
+
+// Final result codes recognised by the response readers
+enum ATResult {
+  AT_PENDING,
+  AT_OK,
+  AT_ERROR,
+  AT_CME_ERROR,
+  AT_CMS_ERROR,
+  AT_PROMPT,    // "> " data prompt (QISEND, CMGS, QMTPUB)
+  AT_CONNECT,   // "CONNECT" / "CONNECT <n>" before a data phase
+  AT_SEND_OK,
+  AT_SEND_FAIL
+};
+
+// Bit masks selecting which results end a read
+#define AT_TERM(result) (1u << (result))
+#define AT_TERM_DEFAULT                                                        \
+  (AT_TERM(AT_OK) | AT_TERM(AT_ERROR) | AT_TERM(AT_CME_ERROR) |                \
+   AT_TERM(AT_CMS_ERROR) | AT_TERM(AT_PROMPT) | AT_TERM(AT_SEND_OK) |          \
+   AT_TERM(AT_SEND_FAIL))
+// End of the line holding the expected text (used when waiting for a URC)
+#define AT_TERM_EXPECT AT_TERM(AT_PENDING)
+
+// Incremental final-result detector. Bytes are fed as they arrive and each
+// line is classified once, when it completes, so detection costs O(1) per
+// byte no matter how long the response grows.
+class ATLineScanner {
+  public:
+    ATLineScanner() { reset(); }
+    void reset();
+    // Returns the result completed by this byte, or AT_PENDING
+    ATResult feed(char c);
+    // Last result seen since reset()
+    ATResult result() const { return _result; }
+    // The line that produced result() (e.g. "+CME ERROR: 10")
+    const char *resultLine() const { return _resultLine; }
+
+  private:
+    char _line[QUECTEL_LINE_BUFFER_SIZE];
+    char _resultLine[QUECTEL_LINE_BUFFER_SIZE];
+    uint8_t _len;
+    ATResult _result;
+
+    ATResult _classify() const;
+};
+
+// View of one field inside a response buffer. Not NUL-terminated and only
+// valid while the buffer it points into is.
+struct ATField {
+    const char *ptr;
+    size_t len;
+
+    bool equals(const char *s) const;
+    long toInt() const;
+    String toString() const;
+    // Copies at most size - 1 bytes and terminates; returns the bytes copied
+    size_t copyTo(char *buf, size_t size) const;
+};
+
+// Single-pass splitter for the comma-separated line that follows a tag
+// ("+CSQ: 23,99"). Fields are trimmed, quoted fields are returned without
+// their quotes and may contain commas. Nothing is copied or allocated.
+class ATTokenizer {
+  public:
+    // An empty tag tokenizes from the start of response
+    ATTokenizer(const char *response, const char *tag = "");
+    // The tag was present
+    bool found() const { return _found; }
+    // Next field on the line; false at the end of the line
+    bool next(ATField &field);
+    // Skips ahead to the field `index` positions past the current one
+    bool field(int index, ATField &out);
+
+  private:
+    const char *_pos;
+    bool _found;
+    bool _done;
+};
+
+// Response sinks. Readers that take a Print& stream every response byte into
+// it and always drain the UART up to the final result code, so long replies
+// (AT+COPS=?, AT+QWIFISCAN, AT+CMGL) are never cut short or left behind to
+// corrupt the next command.
+
+// Keeps the first size-1 bytes in a caller buffer (always NUL-terminated)
+// and counts the rest as dropped.
+class QuectelBufferSink : public Print {
+  public:
+    QuectelBufferSink(char *buffer, size_t size);
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *data, size_t len) override;
+    using Print::write;
+    void clear();
+    const char *c_str() const { return _buffer; }
+    size_t length() const { return _len; }
+    size_t dropped() const { return _dropped; }
+    bool overflowed() const { return _dropped > 0; }
+
+  private:
+    char *_buffer;
+    size_t _size;
+    size_t _len;
+    size_t _dropped;
+};
+
+// Appends to a String, reserving geometrically instead of per byte
+class QuectelStringSink : public Print {
+  public:
+    // `expected` reserves room for that many bytes up front
+    explicit QuectelStringSink(String &str, size_t expected = 0);
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *data, size_t len) override;
+    using Print::write;
+
+  private:
+    String &_str;
+    size_t _reserved;
+};
+
+// Hands the response to a callback in chunks of up to
+// QUECTEL_SINK_CHUNK_SIZE bytes. Call flush() once the read returns.
+#ifndef QUECTEL_SINK_CHUNK_SIZE
+#define QUECTEL_SINK_CHUNK_SIZE 64
+#endif
+typedef void (*QuectelChunkCallback)(const uint8_t *data, size_t len, void *arg);
+
+// Writes a POST body of `length` bytes to `out` (the modem UART) and returns
+// how many it wrote; anything past `length` is dropped
+typedef size_t (*QuectelBodyWriter)(Print &out, size_t length, void *arg);
+
+class QuectelChunkSink : public Print {
+  public:
+    QuectelChunkSink(QuectelChunkCallback callback, void *arg = NULL);
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *data, size_t len) override;
+    using Print::write;
+    void flush() override;
+    size_t total() const { return _total; }
+
+  private:
+    QuectelChunkCallback _callback;
+    void *_arg;
+    uint8_t _chunk[QUECTEL_SINK_CHUNK_SIZE];
+    size_t _len;
+    size_t _total;
+};
+
+// Unsolicited result code dispatch. Handlers are matched by line prefix
+// (e.g. "+QIURC:", "+CMTI:", "RING") and called with the complete line.
+#ifndef QUECTEL_MAX_URC_HANDLERS
+#define QUECTEL_MAX_URC_HANDLERS 8
+#endif
+#ifndef QUECTEL_URC_PREFIX_SIZE
+#define QUECTEL_URC_PREFIX_SIZE 20
+#endif
+// Longer URC lines are delivered truncated
+#ifndef QUECTEL_URC_LINE_SIZE
+#define QUECTEL_URC_LINE_SIZE 128
+#endif
+typedef void (*QuectelUrcHandler)(const char *line, void *arg);
+
+// Splits URC lines out of the byte stream. Lines that could still match a
+// registered prefix are held back until they either complete (and are
+// dispatched) or diverge (and are released to the reader unchanged).
+class URCDispatcher {
+  public:
+    enum Action {
+      URC_PASS,       // byte belongs to the response
+      URC_HOLD,       // byte held while the line might be a URC
+      URC_RELEASE,    // not a URC: emit held() bytes, this one included
+      URC_DISPATCHED  // byte completed or followed a dispatched URC
+    };
+
+    URCDispatcher();
+    bool add(const char *prefix, QuectelUrcHandler handler, void *arg);
+    bool remove(const char *prefix);
+    bool empty() const { return _count == 0; }
+    // solicited: reply the caller is waiting for; URCs of that kind are
+    // passed through instead of dispatched (e.g. "+QIOPEN: 0,0")
+    Action feed(char c, const char *solicited);
+    const char *held() const { return _line; }
+    size_t heldLength() const { return _heldLen; }
+    // The next length bytes after the URC being dispatched are data for sink
+    void payload(size_t length, Print *sink);
+
+  private:
+    struct Entry {
+      char prefix[QUECTEL_URC_PREFIX_SIZE];
+      QuectelUrcHandler handler;
+      void *arg;
+    };
+    Entry _entries[QUECTEL_MAX_URC_HANDLERS];
+    uint8_t _count;
+    char _line[QUECTEL_URC_LINE_SIZE + 1];
+    size_t _len;
+    size_t _heldLen;
+    bool _holding;
+    bool _lineStart;
+    bool _skipLf;
+    Print *_payload;
+    size_t _payloadLeft;
+
+    bool _couldMatch() const;
+    int _longestMatch() const;
+};
+
+// Non-blocking operation (sendATAsync, httpGetAsync ... advanced by loop())
+#ifndef QUECTEL_ASYNC_QUEUE_SIZE
+#define QUECTEL_ASYNC_QUEUE_SIZE 4
+#endif
+#ifndef QUECTEL_ASYNC_CMD_SIZE
+#define QUECTEL_ASYNC_CMD_SIZE 96
+#endif
+#ifndef QUECTEL_ASYNC_EXPECT_SIZE
+#define QUECTEL_ASYNC_EXPECT_SIZE 24
+#endif
+// Head of each async reply passed to its callback
+#ifndef QUECTEL_ASYNC_RESPONSE_SIZE
+#define QUECTEL_ASYNC_RESPONSE_SIZE 256
+#endif
+typedef void (*QuectelCommandCallback)(bool ok, const char *response, void *arg);
+typedef void (*QuectelHttpCallback)(bool ok, const String &body, void *arg);
+
+#if defined(QUECTEL_HAS_WORKER)
+// The UART as seen by the library in worker mode: writes go straight to the
+// port, reads come from the stream buffer the RX task fills.
+class QuectelWorkerStream : public Stream {
+  public:
+    QuectelWorkerStream() : _uart(NULL), _rx(NULL), _peek(-1) {}
+    void attach(Stream *uart, StreamBufferHandle_t rx) { _uart = uart; _rx = rx; }
+    int available() override;
+    int read() override;
+    int peek() override;
+    size_t write(uint8_t c) override { return _uart->write(c); }
+    size_t write(const uint8_t *buffer, size_t size) override { return _uart->write(buffer, size); }
+    using Print::write;
+    int availableForWrite() override { return _uart->availableForWrite(); }
+    void flush() override { _uart->flush(); }
+
+  private:
+    Stream *_uart;
+    StreamBufferHandle_t _rx;
+    int _peek;
+};
+#endif
+
+// How response readers wait for more bytes from the modem
+enum class ReadWaitMode {
+  POLL_DELAY,  // delay() for the poll interval between checks (legacy)
+  SPIN_YIELD,  // re-check immediately, calling yield() or the yield hook
+  RTOS_NOTIFY  // ESP32 HardwareSerial: sleep until the UART signals RX data
+};
+
 class QuectelEC200U {
+  // Host-side benchmarks (extras/host) reach the private parsers through this.
+  friend class QuectelHostProbe;
+  friend class QuectelHttpClient;
+  friend class QuectelHttpCache;
+  friend class QuectelSocketManager;
+  friend class QuectelTransparentSession;
+
   public:
     // HardwareSerial constructor (auto-configure on begin). On ESP32, optional RX/TX pins are supported.
     #if defined(QUECTEL_HAS_HARDWARE_SERIAL)
@@ -104,17 +424,83 @@ class QuectelEC200U {
     
     bool sendAT(const char* cmd, const char* expect, uint32_t timeout = 1000);
     inline bool sendAT(const String &cmd, const String &expect, uint32_t timeout = 1000) { return sendAT(cmd.c_str(), expect.c_str(), timeout); }
+
+    // Rejects commands that were truncated while formatting
+    bool sendAT(const ATCommand &cmd, const char* expect = "OK", uint32_t timeout = 1000);
+
+    // Streams the whole response into sink (see QuectelBufferSink/QuectelChunkSink)
+    bool sendAT(const char* cmd, Print &sink, const char* expect = "OK", uint32_t timeout = 1000);
+    inline bool sendAT(const String &cmd, Print &sink, const char* expect = "OK", uint32_t timeout = 1000) { return sendAT(cmd.c_str(), sink, expect, timeout); }
     
-    void sendATRaw(const char* cmd);
-    inline void sendATRaw(const String &cmd) { sendATRaw(cmd.c_str()); }
+    // False (and nothing is written) while a transparent session owns the UART
+    bool sendATRaw(const char* cmd);
+    bool sendATRaw(const __FlashStringHelper *cmd);
+    inline bool sendATRaw(const String &cmd) { return sendATRaw(cmd.c_str()); }
+    // Rejects commands that were truncated while formatting
+    bool sendATRaw(const ATCommand &cmd);
     
     String readResponse(uint32_t timeout = 1000);
     int readResponse(char* buffer, size_t length, uint32_t timeout);
+    size_t readResponse(Print &sink, uint32_t timeout);
     
     bool sendCommand(const char* cmd, const char* expected, uint32_t timeout = 1000);
     inline bool sendCommand(const String &cmd, const String &expected, uint32_t timeout = 1000) { return sendCommand(cmd.c_str(), expected.c_str(), timeout); }
     void enableDebug(Stream &debugSerial);
 
+    // Response reader tuning. RTOS_NOTIFY is the default on ESP32 with a
+    // HardwareSerial (it installs a HardwareSerial::onReceive callback);
+    // other setups default to SPIN_YIELD. In RTOS_NOTIFY mode the poll
+    // interval caps how long one wait may block; POLL_DELAY restores the
+    // original fixed-sleep behaviour.
+    void setReadWaitMode(ReadWaitMode mode, uint16_t pollIntervalMs = QUECTEL_READ_POLL_INTERVAL_MS);
+    ReadWaitMode getReadWaitMode() const { return _readWaitMode; }
+    // Called between polls in SPIN_YIELD mode instead of yield()
+    void setYieldHook(void (*hook)());
+
+    // Unsolicited result codes. A handler is called with the whole line
+    // whenever one starting with prefix arrives, either from poll() or while
+    // a command is waiting for its reply (the URC is then removed from that
+    // reply). Handlers run inside the reader and must not send AT commands;
+    // set a flag and act on it from loop() instead. URCs a command is
+    // explicitly waiting for (tcpOpen's +QIOPEN, httpGet's +QHTTPGET ...)
+    // still go to that command.
+    bool onURC(const char* prefix, QuectelUrcHandler handler, void *arg = NULL);
+    bool removeURC(const char* prefix);
+    // From inside a handler: the length bytes after the URC line are raw data
+    // (e.g. +QIURC: "recv",<id>,<len> in direct push mode) and go to sink
+    void urcPayload(size_t length, Print &sink) { _urc.payload(length, &sink); }
+    // Drains pending UART input, dispatching URCs. Call it from loop().
+    void poll();
+
+    // Non-blocking operation. Requests are queued and advanced by loop(),
+    // which only consumes bytes the UART already has and returns at once;
+    // callbacks run from loop(). Multi-step operations (attach, HTTP) run as
+    // state machines, one at a time. Don't call the blocking API while
+    // busy(). Each returns false when the queue (or the operation slot) is
+    // full.
+    bool sendATAsync(const char* cmd, QuectelCommandCallback callback = NULL, void *arg = NULL, const char* expect = "OK", uint32_t timeout = 1000);
+    bool waitForNetworkAsync(QuectelCommandCallback callback, void *arg = NULL, uint32_t timeoutMs = 60000);
+    bool attachDataAsync(const char* apn, QuectelCommandCallback callback, void *arg = NULL, const char* user = "", const char* pass = "", int auth = 0);
+    bool httpGetAsync(const char* url, QuectelHttpCallback callback, void *arg = NULL, bool ssl = false);
+    bool httpPostAsync(const char* url, const char* data, QuectelHttpCallback callback, void *arg = NULL, bool ssl = false);
+    // Advances queued work and dispatches URCs; call it every loop()
+    void loop();
+    bool busy() const { return _asyncActive || _asyncCount > 0; }
+    size_t pendingCommands() const { return _asyncCount; }
+
+#if defined(QUECTEL_HAS_WORKER)
+    // ESP32 worker mode (HardwareSerial only; call after begin()). An RX task
+    // drains the UART into a stream buffer at full baud, dispatches URCs
+    // while the modem is idle and wakes readers; every public method then
+    // takes a recursive mutex so several tasks can share the modem. URC
+    // handlers may run in the RX task.
+    bool startWorker(UBaseType_t priority = QUECTEL_WORKER_PRIORITY, BaseType_t core = tskNO_AFFINITY);
+    bool workerRunning() const { return _rxTask != nullptr; }
+    // Hold the modem across several calls from one task
+    void lock();
+    void unlock();
+#endif
+
     // Advanced Features
     bool switchSimCard();
     bool toggleISIM(bool enable);
@@ -238,11 +624,51 @@ class QuectelEC200U {
     bool httpGet(const char* url, String &response, String headers[] = nullptr, size_t header_size = 0);
     bool httpPost(const char* url, const char* data, String &response, String headers[] = nullptr, size_t header_size = 0);
     bool httpPost(const char* url, const JsonDocument &json, String &response, String headers[] = nullptr, size_t header_size = 0);
+    // Writes `length` body bytes from `body`, or from writer(), straight to
+    // the UART after CONNECT, so the body is never held in RAM
+    bool httpPost(const char* url, Stream &body, size_t length, String &response, String headers[] = nullptr, size_t header_size = 0);
+    bool httpPost(const char* url, QuectelBodyWriter writer, void *arg, size_t length, String &response, String headers[] = nullptr, size_t header_size = 0);
+    // Streams the body into sink (a Stream, file, QuectelChunkSink ...) as it
+    // arrives, so memory use does not depend on the body size
+    bool httpGet(const char* url, Print &sink, String headers[] = nullptr, size_t header_size = 0);
+    bool httpGet(const char* url, QuectelChunkCallback callback, void *arg, String headers[] = nullptr, size_t header_size = 0);
     
     // HTTPS
     bool httpsGet(const char* url, String &response, String headers[] = nullptr, size_t header_size = 0);
+    bool httpsGet(const char* url, Print &sink, String headers[] = nullptr, size_t header_size = 0);
+    bool httpsGet(const char* url, QuectelChunkCallback callback, void *arg, String headers[] = nullptr, size_t header_size = 0);
+    // Saves the GET body to the modem filesystem (AT+QHTTPREADFILE), e.g.
+    // path "UFS:fw.bin"; read it back in pieces with fsRead(path, sink)
+    bool httpDownload(const char* url, const char* path, bool ssl = false, String headers[] = nullptr, size_t header_size = 0);
     bool httpsPost(const char* url, const char* data, String &response, String headers[] = nullptr, size_t header_size = 0);
     bool httpsPost(const char* url, const JsonDocument &json, String &response, String headers[] = nullptr, size_t header_size = 0);
+    bool httpsPost(const char* url, Stream &body, size_t length, String &response, String headers[] = nullptr, size_t header_size = 0);
+    bool httpsPost(const char* url, QuectelBodyWriter writer, void *arg, size_t length, String &response, String headers[] = nullptr, size_t header_size = 0);
+
+    // Status and length come from the +QHTTPGET/+QHTTPPOST URC. Response
+    // headers are only fetched when withHeaders is set.
+    struct HttpResponse {
+        int status;         // -1 if the URC carried none
+        long contentLength; // -1 if unknown (e.g. chunked)
+        String headers;     // raw header block, without the blank line
+        String body;
+    };
+    // Return true for any completed request; check response.status. The
+    // body is reserved once from contentLength, and not read at all for an
+    // empty, 204 or 304 response unless headers were asked for.
+    bool httpGet(const char* url, HttpResponse &response, bool withHeaders = false, String headers[] = nullptr, size_t header_size = 0);
+    bool httpsGet(const char* url, HttpResponse &response, bool withHeaders = false, String headers[] = nullptr, size_t header_size = 0);
+    bool httpPost(const char* url, const char* data, HttpResponse &response, bool withHeaders = false, String headers[] = nullptr, size_t header_size = 0);
+    bool httpsPost(const char* url, const char* data, HttpResponse &response, bool withHeaders = false, String headers[] = nullptr, size_t header_size = 0);
+
+    // HTTP compression, off by default. compressRequests gzips buffer and
+    // JsonDocument POST bodies of QUECTEL_GZIP_MIN_BODY bytes or more when
+    // that makes them smaller, and sends Content-Encoding: gzip.
+    // acceptCompressed sends Accept-Encoding: gzip, deflate and inflates
+    // encoded responses on the fly, using a QUECTEL_INFLATE_WINDOW byte heap
+    // buffer per response. Applies to the String, Print and callback
+    // httpGet / httpPost variants; HttpResponse and httpDownload stay raw.
+    void setHttpCompression(bool compressRequests, bool acceptCompressed = true);
 
     // Error handling
     ErrorCode getLastError();
@@ -263,6 +689,9 @@ class QuectelEC200U {
     inline int tcpOpen(const String &host, int port, int ctxId = 1, int socketId = 0) { return tcpOpen(host.c_str(), port, ctxId, socketId); }
     bool tcpSend(int socketId, const char* data);
     inline bool tcpSend(int socketId, const String &data) { return tcpSend(socketId, data.c_str()); }
+    // Binary-safe: raw bytes after the "> " prompt, QUECTEL_TCP_MAX_SEND per
+    // AT+QISEND, each confirmed by SEND OK
+    bool tcpSend(int socketId, const uint8_t* data, size_t length);
 
     bool tcpRecv(int socketId, String &out, size_t bytes = 512, uint32_t timeout = 5000);
     bool tcpClose(int socketId);
@@ -316,8 +745,18 @@ class QuectelEC200U {
     bool fsList(String &out);
     bool fsUpload(const char* path, const char* content);
     inline bool fsUpload(const String &path, const String &content) { return fsUpload(path.c_str(), content.c_str()); }
+    // Binary-safe: exactly `length` bytes, NULs included
+    bool fsUpload(const char* path, const uint8_t *data, size_t length);
     bool fsRead(const char* path, String &out, size_t length = 0);
     inline bool fsRead(const String &path, String &out, size_t length = 0) { return fsRead(path.c_str(), out, length); }
+    // Streams the whole file into sink, chunkSize bytes per AT+QFREAD, so
+    // only one chunk is ever held in RAM
+    bool fsRead(const char* path, Print &sink, size_t chunkSize = 1024);
+    // Open/read/close steps of fsRead. fsOpen returns the handle or -1;
+    // fsReadChunk returns the bytes read, 0 at end of file or -1 on error.
+    int fsOpen(const char* path, int mode = 0);
+    int fsReadChunk(int handle, Print &sink, size_t length);
+    bool fsClose(int handle);
     bool fsDelete(const char* path);
     inline bool fsDelete(const String &path) { return fsDelete(path.c_str()); }
     bool fsExists(const char* path);
@@ -468,6 +907,120 @@ class QuectelEC200U {
     bool _echoDisabled;
     bool _simChecked;
     bool _networkRegistered;
+
+    // Response reader wait strategy
+    ReadWaitMode _readWaitMode;
+    uint16_t _pollIntervalMs;
+    void (*_yieldHook)();
+#if defined(QUECTEL_HAS_WORKER)
+    TaskHandle_t volatile _rxWaiter;
+#endif
+#if defined(QUECTEL_HAS_RX_NOTIFY)
+    bool _rxNotifyAttached;
+    void _attachRxNotify();
+#endif
+
+#if defined(QUECTEL_HAS_WORKER)
+    // Worker mode
+    SemaphoreHandle_t _mutex;
+    TaskHandle_t _rxTask;
+    StreamBufferHandle_t _rxBuffer;
+    QuectelWorkerStream _workerStream;
+    static void _rxTaskEntry(void *arg);
+    void _rxLoop();
+    void _rxDispatchIdle();
+
+    class LockGuard {
+      public:
+        explicit LockGuard(QuectelEC200U &modem) : _mutex(modem._mutex) {
+          if (_mutex) xSemaphoreTakeRecursive(_mutex, portMAX_DELAY);
+        }
+        ~LockGuard() {
+          if (_mutex) xSemaphoreGiveRecursive(_mutex);
+        }
+      private:
+        SemaphoreHandle_t _mutex;
+    };
+#endif
+    void _waitForData(uint32_t maxWaitMs);
+    size_t _writePaced(const uint8_t *data, size_t length);
+    bool _socketSend(int socketId, const uint8_t *data, size_t length);
+
+    URCDispatcher _urc;
+
+
+    // Result of the last response read
+    ATLineScanner _scanner;
+    bool _expectSeen;
+    // A final result line ended on its CR and the LF is still in the UART
+    bool _lfDue;
+    struct ReadContext {
+      Print *sink;
+      const char *expect;     // still to be matched, NULL once seen
+      const char *solicited;  // URCs of this kind go to the reader
+      size_t matched;
+      size_t total;
+      size_t raw;             // bytes to pass through unscanned first
+      bool rawStart;          // raw payload may still start with CONNECT's LF
+      uint16_t terminators;
+    };
+    size_t _readUntil(Print &sink, uint32_t timeout, uint16_t terminators, const char *expect = NULL);
+    size_t _readRaw(Print &sink, size_t length, uint32_t timeout, bool skipLf = true);
+    void _beginRead(ReadContext &ctx, Print &sink, uint16_t terminators, const char *expect);
+    bool _readStep(ReadContext &ctx);
+    bool _readResult();
+    // Fails the call while a transparent session owns the UART
+    bool _commandAllowed();
+
+    // Non-blocking command queue and the multi-step operation it may hold
+    enum AsyncKind { ASYNC_COMMAND, ASYNC_NETWORK, ASYNC_ATTACH, ASYNC_HTTP };
+    struct AsyncRequest {
+      uint8_t kind;
+      char cmd[QUECTEL_ASYNC_CMD_SIZE];
+      char expect[QUECTEL_ASYNC_EXPECT_SIZE];
+      uint32_t timeout;
+      QuectelCommandCallback callback;
+      void *arg;
+    };
+    AsyncRequest _asyncQueue[QUECTEL_ASYNC_QUEUE_SIZE];
+    uint8_t _asyncHead;
+    uint8_t _asyncCount;
+    AsyncRequest _asyncCurrent;
+    bool _asyncActive;     // a request is running
+    bool _asyncReading;    // waiting for a reply (otherwise sleeping)
+    uint32_t _asyncStart;
+    uint32_t _asyncTimeout;
+    ReadContext _asyncCtx;
+    char _asyncResponse[QUECTEL_ASYNC_RESPONSE_SIZE];
+    QuectelBufferSink _asyncSink;
+
+    // State of the running multi-step operation
+    bool _opPending;
+    uint8_t _opStep;
+    bool _opPost;
+    bool _opSsl;
+    int _opAuth;
+    uint32_t _opDeadline;
+    String _opUrl;          // URL, or APN for attach
+    String _opData;         // POST body, or user for attach
+    String _opPass;
+    String _opBody;         // HTTP response body
+    QuectelStringSink _opBodySink;
+    QuectelHttpCallback _opHttpCallback;
+
+    bool _asyncPush(uint8_t kind, const char *cmd, const char *expect, uint32_t timeout, QuectelCommandCallback callback, void *arg);
+    void _asyncStartNext();
+    void _asyncCommand(const char *cmd, const char *expect, uint32_t timeout, uint16_t terminators = AT_TERM_DEFAULT);
+    void _asyncCommand(const String &cmd, const char *expect, uint32_t timeout, uint16_t terminators = AT_TERM_DEFAULT) { _asyncCommand(cmd.c_str(), expect, timeout, terminators); }
+    // A truncated command is not sent and fails the step
+    void _asyncCommand(const ATCommand &cmd, const char *expect, uint32_t timeout, uint16_t terminators = AT_TERM_DEFAULT);
+    void _asyncWait(Print &sink, const char *expect, uint32_t timeout, uint16_t terminators);
+    void _asyncSleep(uint32_t ms);
+    void _asyncComplete(bool ok);
+    void _opFinish(bool ok);
+    void _networkStep(bool ok);
+    void _attachStep(bool ok);
+    void _httpStep(bool ok);
     
     void flushInput();
     bool expectURC(const char* tag, uint32_t timeout);
@@ -476,14 +1029,45 @@ class QuectelEC200U {
     void logDebug(const String &msg);
     void logError(const String &msg);
     void updateNetworkStatus();
-    void _sendHttpHeaders(String headers[], size_t header_size);
-    bool _sendHttpRequest(const String &url, const String &data, String &response, String headers[], size_t header_size, bool ssl, bool isPost);
+    bool _sendHttpHeaders(String headers[], size_t header_size, const char *const extra[] = nullptr, size_t extra_size = 0);
+    bool _sendHttpRequest(const char *url, const char *data, String &response, String headers[], size_t header_size, bool ssl, bool isPost);
+    bool _sendHttpRequest(const char *url, const char *data, Print &body, String headers[], size_t header_size, bool ssl, bool isPost);
+    bool _postHttpBody(const char *url, QuectelBodyWriter writer, void *arg, size_t length, String &response, String headers[], size_t header_size, bool ssl);
+    bool _exchangeHttpRequest(const char *url, QuectelBodyWriter writer, void *arg, size_t length, Print &body, String headers[], size_t header_size, bool ssl, bool isPost);
+    bool _startHttpRequest(const char *url, QuectelBodyWriter writer, void *arg, size_t length, String headers[], size_t header_size, bool ssl, bool isPost, bool encode = false);
+    bool _finishHttpRequest(bool ok);
+    bool _readHttpBody(Print &body, uint32_t timeout, long length = -1, Print *headers = nullptr);
+    bool _readHttpHeaders(Print &sink, uint32_t timeout);
+    bool _fetchHttpResponse(const char *url, const char *data, HttpResponse &response, bool withHeaders, String headers[], size_t header_size, bool ssl, bool isPost);
+    bool _readHttpResponse(HttpResponse &response, bool withHeaders, uint32_t timeout);
+    bool _readHttpFile(const char *path, uint32_t timeout);
+    bool _setResponseHeader(bool on);
+    bool _uploadHttpUrl(const char *url, size_t length);
+    bool _submitHttpRequest(const char *data, size_t length, bool isPost);
+    bool _issueHttpRequest(const char *data, size_t length, bool isPost);
+    bool _issueHttpRequest(QuectelBodyWriter writer, void *arg, size_t length, bool isPost);
+    bool _awaitHttpResponse(bool isPost);
+    // From the last +QHTTPGET / +QHTTPPOST URC (-1 when absent)
+    int _httpStatus;
+    long _httpContentLength;
+    // Bumped whenever the library itself rewrites QHTTPCFG / QHTTPURL, so
+    // QuectelHttpClient knows its cached modem state is stale
+    uint16_t _httpEpoch;
+    // What AT+QHTTPCFG="responseheader" was last set to; every path that
+    // reads a body sets the value it needs through _setResponseHeader()
+    bool _responseHeaderOn;
+    bool _httpCompressRequests;
+    bool _httpAcceptCompressed;
+    // A QuectelTransparentSession owns the UART
+    bool _transparent;
     String _collectResponse(uint32_t timeout);
     bool _extractHttpPayload(const String &raw, String &payload);
     String _getSignalStrengthString(int signal);
     String _getRegistrationStatusString(int regStatus);
-    int _parseCsvInt(const String& response, const String& tag, int index);
-    String _parseCsvString(const String& response, const String& tag, int index);
+    int _parseCsvInt(const char* response, const char* tag, int index);
+    inline int _parseCsvInt(const String& response, const String& tag, int index) { return _parseCsvInt(response.c_str(), tag.c_str(), index); }
+    String _parseCsvString(const char* response, const char* tag, int index);
+    inline String _parseCsvString(const String& response, const String& tag, int index) { return _parseCsvString(response.c_str(), tag.c_str(), index); }
     String _extractFirstLine(const String &resp) const;
     String _utf8ToUcs2Hex(const String &utf8Str);
     String _ucs2HexToUtf8(const String &hexStr);
@@ -0,0 +1,136 @@
+// src/QuectelEC200UClient.cpp
+
+#include "QuectelEC200UClient.h"
+
+QuectelEC200UClient::QuectelEC200UClient(QuectelSocketManager &sockets)
+    : _sockets(sockets), _socket(-1), _head(0), _count(0) {}
+
+QuectelEC200UClient::~QuectelEC200UClient() { stop(); }
+
+int QuectelEC200UClient::connect(IPAddress ip, uint16_t port) {
+  char host[16];
+  snprintf(host, sizeof(host), "%u.%u.%u.%u", ip[0], ip[1], ip[2], ip[3]);
+  return connect(host, port);
+}
+
+int QuectelEC200UClient::connect(const char *host, uint16_t port) {
+  stop();
+  _socket = _sockets.open(host, port);
+  return _socket >= 0 ? 1 : 0;
+}
+
+int QuectelEC200UClient::connect(IPAddress ip, uint16_t port, int32_t) {
+  return connect(ip, port);
+}
+
+int QuectelEC200UClient::connect(const char *host, uint16_t port, int32_t) {
+  return connect(host, port);
+}
+
+size_t QuectelEC200UClient::write(uint8_t c) { return write(&c, 1); }
+
+// One AT+QISEND per QUECTEL_TCP_MAX_SEND bytes; callers that print byte by
+// byte pay a round trip per call, so hand whole packets to write(buf, size)
+size_t QuectelEC200UClient::write(const uint8_t *buf, size_t size) {
+  if (_socket < 0 || !_sockets.send(_socket, buf, size)) {
+    return 0;
+  }
+  return size;
+}
+
+int QuectelEC200UClient::available() {
+  _fill();
+  return (int)_count;
+}
+
+int QuectelEC200UClient::read() {
+  uint8_t c;
+  return read(&c, 1) == 1 ? c : -1;
+}
+
+int QuectelEC200UClient::read(uint8_t *buf, size_t size) {
+  if (_socket < 0 || size == 0) {
+    return -1;
+  }
+  if (_count == 0) {
+    // Large reads go straight into the caller's buffer
+    if (size >= sizeof(_rx)) {
+      _sockets.poll();
+      if (!_sockets.hasData(_socket)) {
+        return -1;
+      }
+      int n = _sockets.read(_socket, buf, size);
+      return n > 0 ? n : -1;
+    }
+    if (!_fill()) {
+      return -1;
+    }
+  }
+  size_t total = 0;
+  while (total < size && _count > 0) {
+    size_t run = sizeof(_rx) - _head;
+    if (run > _count) {
+      run = _count;
+    }
+    if (run > size - total) {
+      run = size - total;
+    }
+    memcpy(buf + total, _rx + _head, run);
+    _head = (_head + run) % sizeof(_rx);
+    _count -= run;
+    total += run;
+  }
+  return (int)total;
+}
+
+int QuectelEC200UClient::peek() {
+  if (_count == 0 && !_fill()) {
+    return -1;
+  }
+  return _rx[_head];
+}
+
+void QuectelEC200UClient::stop() {
+  if (_socket >= 0) {
+    _sockets.close(_socket);
+    _socket = -1;
+  }
+  _head = 0;
+  _count = 0;
+}
+
+// Still true after the peer closed while unread bytes remain
+uint8_t QuectelEC200UClient::connected() {
+  if (_socket < 0) {
+    return 0;
+  }
+  if (_count > 0) {
+    return 1;
+  }
+  _sockets.poll();
+  return _sockets.state(_socket) == QuectelSocketState::OPEN ||
+         _sockets.hasData(_socket);
+}
+
+// Tops the ring buffer up from the modem, into the largest contiguous free
+// span, once the modem has announced data for the socket
+bool QuectelEC200UClient::_fill() {
+  if (_socket < 0 || _count == sizeof(_rx)) {
+    return false;
+  }
+  _sockets.poll();
+  if (!_sockets.hasData(_socket)) {
+    return false;
+  }
+  if (_count == 0) {
+    _head = 0;
+  }
+  size_t tail = (_head + _count) % sizeof(_rx);
+  size_t span = tail >= _head ? sizeof(_rx) - tail : _head - tail;
+  int n = _sockets.read(_socket, _rx + tail, span);
+  if (n <= 0) {
+    return false;
+  }
+  _count += n;
+  return true;
+}
@@ -0,0 +1,58 @@
+// src/QuectelEC200UClient.h
+
+#ifndef QUECTEL_EC200U_CLIENT_H
+#define QUECTEL_EC200U_CLIENT_H
+
+#include "QuectelSocketManager.h"
+#include <Arduino.h>
+#include <Client.h>
+
+// Local receive buffer per client, refilled with AT+QIRD
+#ifndef QUECTEL_CLIENT_RX_BUFFER
+#define QUECTEL_CLIENT_RX_BUFFER 512
+#endif
+
+// Arduino Client over one modem socket, for libraries written against
+// Client (PubSubClient, ArduinoHttpClient, ArduinoWebsockets ...). Sockets
+// come from a shared QuectelSocketManager, so several clients can be
+// connected at once; AT+QIRD is only issued after the modem announced data.
+//
+//   QuectelSocketManager sockets(modem);
+//   QuectelEC200UClient net(sockets);
+//   PubSubClient mqtt(net);
+//   sockets.begin();
+class QuectelEC200UClient : public Client {
+public:
+  explicit QuectelEC200UClient(QuectelSocketManager &sockets);
+  ~QuectelEC200UClient();
+
+  int connect(IPAddress ip, uint16_t port) override;
+  int connect(const char *host, uint16_t port) override;
+  // Timeout variants some cores declare; the modem applies its own
+  int connect(IPAddress ip, uint16_t port, int32_t timeout);
+  int connect(const char *host, uint16_t port, int32_t timeout);
+  size_t write(uint8_t c) override;
+  size_t write(const uint8_t *buf, size_t size) override;
+  using Print::write;
+  int available() override;
+  int read() override;
+  int read(uint8_t *buf, size_t size) override;
+  int peek() override;
+  void flush() override {}
+  void stop() override;
+  uint8_t connected() override;
+  operator bool() override { return _socket >= 0; }
+
+  int socketId() const { return _socket; }
+
+private:
+  QuectelSocketManager &_sockets;
+  int _socket;
+  uint8_t _rx[QUECTEL_CLIENT_RX_BUFFER];
+  size_t _head;  // next byte to read
+  size_t _count; // bytes buffered
+
+  bool _fill();
+};
+
+#endif
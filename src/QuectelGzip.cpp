@@ -0,0 +1,655 @@
+// src/QuectelGzip.cpp
+
+#include "QuectelGzip.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+namespace {
+// RFC 1951 length and distance codes: base value and extra bits
+const uint16_t LENGTH_BASE[29] = {3,  4,  5,  6,   7,   8,   9,   10,  11, 13,
+                                  15, 17, 19, 23,  27,  31,  35,  43,  51, 59,
+                                  67, 83, 99, 115, 131, 163, 195, 227, 258};
+const uint8_t LENGTH_EXTRA[29] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2,
+                                  2, 3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+const uint16_t DISTANCE_BASE[30] = {
+    1,    2,    3,    4,    5,    7,     9,     13,    17,  25,
+    33,   49,   65,   97,   129,  193,   257,   385,   513, 769,
+    1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577};
+const uint8_t DISTANCE_EXTRA[30] = {0, 0, 0, 0, 1, 1, 2, 2,  3,  3,  4,  4,  5,  5,  6,
+                                6, 7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+// Order in which code length code lengths are sent
+const uint8_t CLEN_ORDER[19] = {16, 17, 18, 0, 8,  7, 9,  6, 10, 5,
+                                11, 4,  12, 3, 13, 2, 14, 1, 15};
+
+// CRC-32 (IEEE), four bits at a time to keep the table small
+const uint32_t CRC_NIBBLE[16] = {
+    0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac, 0x76dc4190, 0x6b6b51f4,
+    0x4db26158, 0x5005713c, 0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c,
+    0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c};
+
+uint32_t crc32Update(uint32_t crc, const uint8_t *data, size_t len) {
+  crc = ~crc;
+  while (len--) {
+    crc ^= *data++;
+    crc = (crc >> 4) ^ CRC_NIBBLE[crc & 15];
+    crc = (crc >> 4) ^ CRC_NIBBLE[crc & 15];
+  }
+  return ~crc;
+}
+
+uint16_t reverseBits(uint16_t code, uint8_t length) {
+  uint16_t out = 0;
+  while (length--) {
+    out = (out << 1) | (code & 1);
+    code >>= 1;
+  }
+  return out;
+}
+
+const uint32_t WINDOW_MASK = QUECTEL_INFLATE_WINDOW - 1;
+} // namespace
+
+// ===== Inflate =====
+QuectelInflater::QuectelInflater(Print &out)
+    : _out(out), _window(NULL), _state(WRAPPER), _wrapper(RAW), _flags(0),
+      _last(false), _in(NULL), _inEnd(NULL), _bits(0), _bitCount(0), _code(0),
+      _first(0), _index(0), _len(0), _count(0), _written(0), _flushed(0),
+      _check(0), _adlerB(0) {}
+
+QuectelInflater::~QuectelInflater() { free(_window); }
+
+size_t QuectelInflater::write(uint8_t c) { return write(&c, 1); }
+
+size_t QuectelInflater::write(const uint8_t *data, size_t len) {
+  if (_window == NULL && _state == WRAPPER) {
+    _window = (uint8_t *)malloc(QUECTEL_INFLATE_WINDOW);
+    if (_window == NULL) {
+      _state = FAILED;
+    }
+  }
+  _in = data;
+  _inEnd = data + len;
+  while (_state != DONE && _state != FAILED && _step()) {
+  }
+  _flush();
+  // Report everything as consumed so readers keep draining the UART
+  return len;
+}
+
+// Makes at least n (<= 24) bits available; false when input runs out
+bool QuectelInflater::_need(uint8_t n) {
+  while (_bitCount < n) {
+    if (_in == _inEnd) {
+      return false;
+    }
+    _bits |= (uint32_t)*_in++ << _bitCount;
+    _bitCount += 8;
+  }
+  return true;
+}
+
+uint32_t QuectelInflater::_take(uint8_t n) {
+  uint32_t value = _bits & ((1UL << n) - 1);
+  _bits >>= n;
+  _bitCount -= n;
+  return value;
+}
+
+// Canonical Huffman decode one bit at a time, so it can stop and resume
+// anywhere. Returns the symbol, -1 for more input, -2 for a bad code.
+int QuectelInflater::_decode(const uint16_t *count, const uint16_t *symbol) {
+  while (_need(1)) {
+    _code |= _take(1);
+    _len++;
+    uint16_t n = count[_len];
+    if (_code < _first + n) {
+      int value = symbol[_index + (_code - _first)];
+      _code = _first = _index = 0;
+      _len = 0;
+      return value;
+    }
+    _index += n;
+    _first = (_first + n) << 1;
+    _code <<= 1;
+    if (_len == 15) {
+      return -2;
+    }
+  }
+  return -1;
+}
+
+bool QuectelInflater::_build(uint16_t *count, uint16_t *symbol,
+                             const uint16_t *lengths, int n) {
+  uint16_t offs[16];
+  memset(count, 0, 16 * sizeof(uint16_t));
+  for (int i = 0; i < n; i++) {
+    count[lengths[i]]++;
+  }
+  if (count[0] == n) {
+    return true; // no codes; only an error if one is used
+  }
+  int left = 1;
+  for (int len = 1; len < 16; len++) {
+    left <<= 1;
+    left -= count[len];
+    if (left < 0) {
+      return false; // over-subscribed
+    }
+  }
+  offs[1] = 0;
+  for (int len = 1; len < 15; len++) {
+    offs[len + 1] = offs[len] + count[len];
+  }
+  for (int i = 0; i < n; i++) {
+    if (lengths[i] != 0) {
+      symbol[offs[lengths[i]]++] = i;
+    }
+  }
+  return true;
+}
+
+void QuectelInflater::_fixedTables() {
+  for (int i = 0; i < 288; i++) {
+    _lengths[i] = i < 144 ? 8 : i < 256 ? 9 : i < 280 ? 7 : 8;
+  }
+  _build(_lenCount, _lenSymbol, _lengths, 288);
+  for (int i = 0; i < 30; i++) {
+    _lengths[i] = 5;
+  }
+  _build(_distCount, _distSymbol, _lengths, 30);
+}
+
+void QuectelInflater::_put(uint8_t c) {
+  _window[_written & WINDOW_MASK] = c;
+  _written++;
+  if (_written - _flushed == QUECTEL_INFLATE_WINDOW) {
+    _flush();
+  }
+}
+
+// Hands decoded bytes to the sink and folds them into the checksum
+void QuectelInflater::_flush() {
+  while (_flushed != _written && _window != NULL) {
+    uint32_t start = _flushed & WINDOW_MASK;
+    uint32_t n = _written - _flushed;
+    if (start + n > QUECTEL_INFLATE_WINDOW) {
+      n = QUECTEL_INFLATE_WINDOW - start;
+    }
+    const uint8_t *p = _window + start;
+    if (_wrapper == GZIP) {
+      _check = crc32Update(_check, p, n);
+    } else if (_wrapper == ZLIB) {
+      for (uint32_t i = 0; i < n; i++) {
+        _check = (_check + p[i]) % 65521;
+        _adlerB = (_adlerB + _check) % 65521;
+      }
+    }
+    _out.write(p, n);
+    _flushed += n;
+  }
+}
+
+// Advances the state machine by one step; false when it needs more input
+bool QuectelInflater::_step() {
+  switch (_state) {
+  case WRAPPER: {
+    if (!_need(16)) {
+      return false;
+    }
+    uint8_t b0 = _bits & 0xff, b1 = (_bits >> 8) & 0xff;
+    if (b0 == 0x1f && b1 == 0x8b) {
+      _wrapper = GZIP;
+      _check = 0;
+      _count = 0;
+      _state = GZIP_HEADER;
+    } else if ((b0 & 0x0f) == 8 && ((b0 << 8) | b1) % 31 == 0 &&
+               !(b1 & 0x20)) {
+      _take(16);
+      _wrapper = ZLIB;
+      _check = 1;
+      _adlerB = 0;
+      _state = BLOCK;
+    } else {
+      _state = BLOCK; // raw deflate
+    }
+    return true;
+  }
+  case GZIP_HEADER:
+    // ID1 ID2 CM FLG MTIME(4) XFL OS
+    if (!_need(8)) {
+      return false;
+    }
+    {
+      uint8_t b = _take(8);
+      if (_count == 2 && b != 8) {
+        _state = FAILED;
+        return false;
+      }
+      if (_count == 3) {
+        _flags = b;
+      }
+    }
+    if (++_count == 10) {
+      _count = 0;
+      _state = GZIP_EXTRA_LEN;
+    }
+    return true;
+  case GZIP_EXTRA_LEN:
+    if (!(_flags & 0x04)) {
+      _state = GZIP_NAME;
+      return true;
+    }
+    if (!_need(16)) {
+      return false;
+    }
+    _count = _take(16);
+    _state = GZIP_EXTRA;
+    return true;
+  case GZIP_EXTRA:
+    if (_count == 0) {
+      _state = GZIP_NAME;
+      return true;
+    }
+    if (!_need(8)) {
+      return false;
+    }
+    _take(8);
+    _count--;
+    return true;
+  case GZIP_NAME:
+  case GZIP_COMMENT: {
+    uint8_t flag = _state == GZIP_NAME ? 0x08 : 0x10;
+    if (_flags & flag) {
+      if (!_need(8)) {
+        return false;
+      }
+      if (_take(8) != 0) {
+        return true;
+      }
+    }
+    _state = _state == GZIP_NAME ? GZIP_COMMENT : GZIP_HCRC;
+    return true;
+  }
+  case GZIP_HCRC:
+    if (_flags & 0x02) {
+      if (!_need(16)) {
+        return false;
+      }
+      _take(16);
+    }
+    _state = BLOCK;
+    return true;
+  case BLOCK: {
+    if (!_need(3)) {
+      return false;
+    }
+    _last = _take(1);
+    uint8_t type = _take(2);
+    if (type == 0) {
+      _take(_bitCount & 7);
+      _state = STORED_LEN;
+    } else if (type == 1) {
+      _fixedTables();
+      _state = LITLEN;
+    } else if (type == 2) {
+      _state = TABLE_SIZES;
+    } else {
+      _state = FAILED;
+    }
+    return true;
+  }
+  case STORED_LEN: {
+    if (!_need(16)) {
+      return false;
+    }
+    uint16_t len = _take(16);
+    if (!_need(16)) {
+      // Put LEN back; the bit buffer is byte aligned here
+      _bits = (_bits << 16) | len;
+      _bitCount += 16;
+      return false;
+    }
+    if ((uint16_t)~_take(16) != len) {
+      _state = FAILED;
+      return false;
+    }
+    _count = len;
+    _state = STORED;
+    return true;
+  }
+  case STORED:
+    while (_count > 0) {
+      if (!_need(8)) {
+        return false;
+      }
+      _put(_take(8));
+      _count--;
+    }
+    _state = _last ? TRAILER : BLOCK;
+    return true;
+  case TABLE_SIZES:
+    if (!_need(14)) {
+      return false;
+    }
+    _nlen = _take(5) + 257;
+    _ndist = _take(5) + 1;
+    _ncode = _take(4) + 4;
+    if (_nlen > 286 || _ndist > 30) {
+      _state = FAILED;
+      return false;
+    }
+    memset(_lengths, 0, sizeof(_lengths));
+    _lenIndex = 0;
+    _state = TABLE_CLEN;
+    return true;
+  case TABLE_CLEN:
+    while (_lenIndex < _ncode) {
+      if (!_need(3)) {
+        return false;
+      }
+      _lengths[CLEN_ORDER[_lenIndex++]] = _take(3);
+    }
+    // The code length code goes in the litlen table until that is built
+    if (!_build(_lenCount, _lenSymbol, _lengths, 19)) {
+      _state = FAILED;
+      return false;
+    }
+    memset(_lengths, 0, sizeof(_lengths));
+    _lenIndex = 0;
+    _state = TABLE_LENS;
+    return true;
+  case TABLE_LENS:
+    while (_lenIndex < _nlen + _ndist) {
+      int sym = _decode(_lenCount, _lenSymbol);
+      if (sym == -1) {
+        return false;
+      }
+      if (sym < 0) {
+        _state = FAILED;
+        return false;
+      }
+      if (sym < 16) {
+        _lengths[_lenIndex++] = sym;
+      } else {
+        if (sym == 16 && _lenIndex == 0) {
+          _state = FAILED;
+          return false;
+        }
+        _symbol = sym;
+        _state = TABLE_REPEAT;
+        return true;
+      }
+    }
+    if (_lengths[256] == 0 ||
+        !_build(_lenCount, _lenSymbol, _lengths, _nlen) ||
+        !_build(_distCount, _distSymbol, _lengths + _nlen, _ndist)) {
+      _state = FAILED;
+      return false;
+    }
+    _state = LITLEN;
+    return true;
+  case TABLE_REPEAT: {
+    uint8_t extra = _symbol == 16 ? 2 : _symbol == 17 ? 3 : 7;
+    if (!_need(extra)) {
+      return false;
+    }
+    uint16_t repeat = _take(extra) + (_symbol == 18 ? 11 : 3);
+    uint16_t value = _symbol == 16 ? _lengths[_lenIndex - 1] : 0;
+    if (_lenIndex + repeat > _nlen + _ndist) {
+      _state = FAILED;
+      return false;
+    }
+    while (repeat--) {
+      _lengths[_lenIndex++] = value;
+    }
+    _state = TABLE_LENS;
+    return true;
+  }
+  case LITLEN: {
+    int sym = _decode(_lenCount, _lenSymbol);
+    if (sym == -1) {
+      return false;
+    }
+    if (sym < 0 || sym > 285) {
+      _state = FAILED;
+      return false;
+    }
+    if (sym < 256) {
+      _put(sym);
+    } else if (sym == 256) {
+      _state = _last ? TRAILER : BLOCK;
+    } else {
+      _symbol = sym - 257;
+      _state = LEN_EXTRA;
+    }
+    return true;
+  }
+  case LEN_EXTRA:
+    if (!_need(LENGTH_EXTRA[_symbol])) {
+      return false;
+    }
+    _copyLen = LENGTH_BASE[_symbol] + _take(LENGTH_EXTRA[_symbol]);
+    _state = DIST;
+    return true;
+  case DIST: {
+    int sym = _decode(_distCount, _distSymbol);
+    if (sym == -1) {
+      return false;
+    }
+    if (sym < 0 || sym > 29) {
+      _state = FAILED;
+      return false;
+    }
+    _symbol = sym;
+    _state = DIST_EXTRA;
+    return true;
+  }
+  case DIST_EXTRA: {
+    if (!_need(DISTANCE_EXTRA[_symbol])) {
+      return false;
+    }
+    uint32_t dist = DISTANCE_BASE[_symbol] + _take(DISTANCE_EXTRA[_symbol]);
+    if (dist > _written || dist > QUECTEL_INFLATE_WINDOW) {
+      _state = FAILED;
+      return false;
+    }
+    while (_copyLen--) {
+      _put(_window[(_written - dist) & WINDOW_MASK]);
+    }
+    _state = LITLEN;
+    return true;
+  }
+  case TRAILER: {
+    uint8_t size = _wrapper == GZIP ? 8 : _wrapper == ZLIB ? 4 : 0;
+    if (_count == 0) {
+      _take(_bitCount & 7);
+    }
+    while (_count < size) {
+      if (!_need(8)) {
+        return false;
+      }
+      _trailer[_count++] = _take(8);
+    }
+    _flush();
+    bool ok = true;
+    if (_wrapper == GZIP) {
+      uint32_t crc = _trailer[0] | (uint32_t)_trailer[1] << 8 |
+                     (uint32_t)_trailer[2] << 16 | (uint32_t)_trailer[3] << 24;
+      uint32_t isize = _trailer[4] | (uint32_t)_trailer[5] << 8 |
+                       (uint32_t)_trailer[6] << 16 |
+                       (uint32_t)_trailer[7] << 24;
+      ok = crc == _check && isize == _written;
+    } else if (_wrapper == ZLIB) {
+      uint32_t adler = (uint32_t)_trailer[0] << 24 |
+                       (uint32_t)_trailer[1] << 16 |
+                       (uint32_t)_trailer[2] << 8 | _trailer[3];
+      ok = adler == ((_adlerB << 16) | _check);
+    }
+    _state = ok ? DONE : FAILED;
+    return false;
+  }
+  case DONE:
+  case FAILED:
+    return false;
+  }
+  return false;
+}
+
+// ===== Deflate =====
+QuectelDeflater::QuectelDeflater(Print &out)
+    : _out(out), _fill(0), _done(0), _started(false), _bits(0), _bitCount(0),
+      _chunkLen(0), _crc(0), _size(0), _produced(0) {
+  memset(_head, 0, sizeof(_head));
+}
+
+size_t QuectelDeflater::write(uint8_t c) { return write(&c, 1); }
+
+size_t QuectelDeflater::write(const uint8_t *data, size_t len) {
+  _crc = crc32Update(_crc, data, len);
+  _size += len;
+  size_t left = len;
+  while (left > 0) {
+    size_t n = sizeof(_buf) - _fill;
+    if (n > left) {
+      n = left;
+    }
+    memcpy(_buf + _fill, data, n);
+    _fill += n;
+    data += n;
+    left -= n;
+    if (_fill == sizeof(_buf)) {
+      // Keep a full match of lookahead, then slide the history down
+      _compress(_fill - 258);
+      memmove(_buf, _buf + QUECTEL_DEFLATE_WINDOW, QUECTEL_DEFLATE_WINDOW);
+      _fill -= QUECTEL_DEFLATE_WINDOW;
+      _done -= QUECTEL_DEFLATE_WINDOW;
+      for (size_t i = 0; i < (1 << QUECTEL_DEFLATE_HASH_BITS); i++) {
+        _head[i] = _head[i] > QUECTEL_DEFLATE_WINDOW
+                       ? _head[i] - QUECTEL_DEFLATE_WINDOW
+                       : 0;
+      }
+    }
+  }
+  return len;
+}
+
+void QuectelDeflater::finish() {
+  _compress(_fill);
+  _putCode(0, 7); // end of block
+  if (_bitCount > 0) {
+    _putBits(0, 8 - _bitCount);
+  }
+  for (int i = 0; i < 4; i++) {
+    _putByte(_crc >> (8 * i));
+  }
+  for (int i = 0; i < 4; i++) {
+    _putByte(_size >> (8 * i));
+  }
+  _flushChunk();
+}
+
+// Greedy LZ77 from _done up to `end`, one hash probe per position.
+// Matches may run into the lookahead but never past _fill.
+void QuectelDeflater::_compress(size_t end) {
+  if (!_started) {
+    static const uint8_t header[10] = {0x1f, 0x8b, 8, 0, 0, 0, 0, 0, 0, 0xff};
+    for (size_t i = 0; i < sizeof(header); i++) {
+      _putByte(header[i]);
+    }
+    _putBits(1, 1); // BFINAL: everything goes in one block
+    _putBits(1, 2); // BTYPE 01, fixed Huffman codes
+    _started = true;
+  }
+  while (_done < end) {
+    size_t best = 0;
+    size_t dist = 0;
+    if (_done + 3 <= _fill) {
+      const uint8_t *p = _buf + _done;
+      uint16_t h = ((p[0] << 16 | p[1] << 8 | p[2]) * 2654435761u) >>
+                   (32 - QUECTEL_DEFLATE_HASH_BITS);
+      size_t cand = _head[h];
+      _head[h] = _done + 1;
+      if (cand > 0) {
+        const uint8_t *q = _buf + cand - 1;
+        size_t max = _fill - _done < 258 ? _fill - _done : 258;
+        while (best < max && q[best] == p[best]) {
+          best++;
+        }
+        dist = _done - (cand - 1);
+      }
+    }
+    if (best >= 3) {
+      _match(best, dist);
+      // Index the positions inside the match too, for later references
+      for (size_t i = 1; i < best && _done + i + 3 <= _fill; i++) {
+        const uint8_t *p = _buf + _done + i;
+        uint16_t h = ((p[0] << 16 | p[1] << 8 | p[2]) * 2654435761u) >>
+                     (32 - QUECTEL_DEFLATE_HASH_BITS);
+        _head[h] = _done + i + 1;
+      }
+      _done += best;
+    } else {
+      _literal(_buf[_done++]);
+    }
+  }
+}
+
+void QuectelDeflater::_literal(uint8_t c) {
+  if (c < 144) {
+    _putCode(0x30 + c, 8);
+  } else {
+    _putCode(0x190 + (c - 144), 9);
+  }
+}
+
+void QuectelDeflater::_match(size_t length, size_t distance) {
+  int code = 28;
+  while (LENGTH_BASE[code] > length) {
+    code--;
+  }
+  uint16_t sym = 257 + code;
+  if (sym < 280) {
+    _putCode(sym - 256, 7);
+  } else {
+    _putCode(0xc0 + (sym - 280), 8);
+  }
+  _putBits(length - LENGTH_BASE[code], LENGTH_EXTRA[code]);
+
+  code = 29;
+  while (DISTANCE_BASE[code] > distance) {
+    code--;
+  }
+  _putCode(code, 5);
+  _putBits(distance - DISTANCE_BASE[code], DISTANCE_EXTRA[code]);
+}
+
+void QuectelDeflater::_putBits(uint32_t value, uint8_t count) {
+  _bits |= value << _bitCount;
+  _bitCount += count;
+  while (_bitCount >= 8) {
+    _putByte(_bits & 0xff);
+    _bits >>= 8;
+    _bitCount -= 8;
+  }
+}
+
+// Huffman codes are defined most significant bit first
+void QuectelDeflater::_putCode(uint16_t code, uint8_t length) {
+  _putBits(reverseBits(code, length), length);
+}
+
+void QuectelDeflater::_putByte(uint8_t b) {
+  _chunk[_chunkLen++] = b;
+  _produced++;
+  if (_chunkLen == sizeof(_chunk)) {
+    _flushChunk();
+  }
+}
+
+void QuectelDeflater::_flushChunk() {
+  if (_chunkLen > 0) {
+    _out.write(_chunk, _chunkLen);
+    _chunkLen = 0;
+  }
+}
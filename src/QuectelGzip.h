@@ -0,0 +1,130 @@
+// src/QuectelGzip.h
+
+#ifndef QUECTEL_GZIP_H
+#define QUECTEL_GZIP_H
+
+#include <Arduino.h>
+
+// History kept by the inflater. Deflate streams may refer back up to 32 KB,
+// so only lower this for servers known to compress with a smaller window.
+#ifndef QUECTEL_INFLATE_WINDOW
+#define QUECTEL_INFLATE_WINDOW 32768
+#endif
+// History searched by the deflater; more finds longer matches, costs RAM
+// (twice this plus the hash table) and time
+#ifndef QUECTEL_DEFLATE_WINDOW
+#define QUECTEL_DEFLATE_WINDOW 512
+#endif
+#ifndef QUECTEL_DEFLATE_HASH_BITS
+#define QUECTEL_DEFLATE_HASH_BITS 8
+#endif
+// Smaller request bodies are sent as they are
+#ifndef QUECTEL_GZIP_MIN_BODY
+#define QUECTEL_GZIP_MIN_BODY 128
+#endif
+
+// Streaming gzip / zlib / raw deflate decoder. Compressed bytes written to
+// it come out decompressed on `out`; input may arrive in pieces of any size.
+// The window is allocated from the heap on the first write.
+class QuectelInflater : public Print {
+  public:
+    explicit QuectelInflater(Print &out);
+    ~QuectelInflater();
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *data, size_t len) override;
+    using Print::write;
+
+    // The whole stream, trailer checksum included, has been decoded
+    bool finished() const { return _state == DONE; }
+    bool failed() const { return _state == FAILED; }
+    // Decompressed bytes produced so far
+    uint32_t total() const { return _written; }
+
+  private:
+    enum State {
+      WRAPPER, GZIP_HEADER, GZIP_EXTRA_LEN, GZIP_EXTRA, GZIP_NAME,
+      GZIP_COMMENT, GZIP_HCRC, BLOCK, STORED_LEN, STORED, TABLE_SIZES,
+      TABLE_CLEN, TABLE_LENS, TABLE_REPEAT, LITLEN, LEN_EXTRA, DIST,
+      DIST_EXTRA, TRAILER, DONE, FAILED
+    };
+    enum Wrapper { RAW, GZIP, ZLIB };
+
+    Print &_out;
+    uint8_t *_window;
+    State _state;
+    Wrapper _wrapper;
+    uint8_t _flags;
+    bool _last;
+    // Input bits not consumed yet, least significant first
+    const uint8_t *_in;
+    const uint8_t *_inEnd;
+    uint32_t _bits;
+    uint8_t _bitCount;
+    // Resumable Huffman decode
+    uint16_t _code, _first, _index;
+    uint8_t _len;
+    // Block and table state
+    uint32_t _count;
+    uint16_t _nlen, _ndist, _ncode, _lenIndex;
+    uint16_t _symbol;
+    uint16_t _copyLen;
+    uint16_t _lengths[320];
+    uint16_t _lenCount[16], _lenSymbol[288];
+    uint16_t _distCount[16], _distSymbol[32];
+    // Output
+    uint32_t _written;
+    uint32_t _flushed;
+    uint32_t _check;
+    uint32_t _adlerB;
+    uint8_t _trailer[8];
+
+    bool _need(uint8_t n);
+    uint32_t _take(uint8_t n);
+    int _decode(const uint16_t *count, const uint16_t *symbol);
+    static bool _build(uint16_t *count, uint16_t *symbol, const uint16_t *lengths, int n);
+    void _fixedTables();
+    void _put(uint8_t c);
+    void _flush();
+    bool _step();
+};
+
+// Streaming gzip encoder for request bodies: LZ77 over a small history and
+// the fixed Huffman code, which suits short, repetitive JSON. Bytes written
+// to it go out compressed on `out`; call finish() once at the end. The
+// output depends only on the input, so a first pass into a counting Print
+// gives the exact length to announce before a second, real pass.
+class QuectelDeflater : public Print {
+  public:
+    explicit QuectelDeflater(Print &out);
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t *data, size_t len) override;
+    using Print::write;
+    // Ends the stream and writes the gzip trailer
+    void finish();
+    uint32_t compressedSize() const { return _produced; }
+
+  private:
+    Print &_out;
+    uint8_t _buf[2 * QUECTEL_DEFLATE_WINDOW];
+    uint16_t _head[1 << QUECTEL_DEFLATE_HASH_BITS];
+    size_t _fill;
+    size_t _done;
+    bool _started;
+    uint32_t _bits;
+    uint8_t _bitCount;
+    uint8_t _chunk[32];
+    size_t _chunkLen;
+    uint32_t _crc;
+    uint32_t _size;
+    uint32_t _produced;
+
+    void _compress(size_t end);
+    void _literal(uint8_t c);
+    void _match(size_t length, size_t distance);
+    void _putBits(uint32_t value, uint8_t count);
+    void _putCode(uint16_t code, uint8_t length);
+    void _putByte(uint8_t b);
+    void _flushChunk();
+};
+
+#endif
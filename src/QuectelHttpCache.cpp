@@ -0,0 +1,238 @@
+// src/QuectelHttpCache.cpp
+
+#include "QuectelHttpCache.h"
+
+QuectelHttpCache::QuectelHttpCache(QuectelEC200U &modem, const char *fsPrefix)
+    : _modem(modem), _client(modem), _fsPrefix(fsPrefix), _next(0),
+      _hits(0), _misses(0) {
+  for (size_t i = 0; i < QUECTEL_HTTP_CACHE_SIZE; i++) {
+    _entries[i].key = 0;
+  }
+}
+
+bool QuectelHttpCache::get(const char *url, String &body, String headers[],
+                           size_t header_size, bool *fromCache) {
+  body = "";
+  if (fromCache != nullptr) {
+    *fromCache = false;
+  }
+  if (header_size + 2 > QUECTEL_HTTP_CACHE_MAX_HEADERS) {
+    _modem._lastError = ErrorCode::UNKNOWN;
+    return false;
+  }
+
+  uint32_t key = _hashUrl(url);
+  Entry *entry = _find(key, url);
+  if (entry == nullptr && _fsPrefix != nullptr) {
+    entry = _load(key, url);
+  }
+
+  // Caller headers plus the validators
+  String request[QUECTEL_HTTP_CACHE_MAX_HEADERS];
+  size_t count = 0;
+  for (size_t i = 0; i < header_size; i++) {
+    request[count++] = headers[i];
+  }
+  if (entry != nullptr && entry->etag.length() > 0) {
+    request[count++] = "If-None-Match: " + entry->etag;
+  }
+  if (entry != nullptr && entry->lastModified.length() > 0) {
+    request[count++] = "If-Modified-Since: " + entry->lastModified;
+  }
+
+  QuectelEC200U::HttpResponse response;
+  if (!_client.get(url, response, true, request, count)) {
+    return false;
+  }
+
+  if (response.status == 304 && entry != nullptr) {
+    if (!_readBody(*entry, body)) {
+      // Lost the stored body; fetch in full next time
+      entry->key = 0;
+      return false;
+    }
+    _hits++;
+    if (fromCache != nullptr) {
+      *fromCache = true;
+    }
+    return true;
+  }
+
+  _misses++;
+  if (response.status != 200) {
+    _modem._lastError = ErrorCode::HTTP_ERROR;
+    return false;
+  }
+  _store(key, url, response);
+  body = response.body;
+  return true;
+}
+
+void QuectelHttpCache::clear() {
+  for (size_t i = 0; i < QUECTEL_HTTP_CACHE_SIZE; i++) {
+    Entry &entry = _entries[i];
+    if (entry.key != 0 && _fsPrefix != nullptr) {
+      char path[48];
+      _path(path, sizeof(path), entry.key, ".tag");
+      _modem.fsDelete(path);
+      _path(path, sizeof(path), entry.key, ".bin");
+      _modem.fsDelete(path);
+    }
+    entry.key = 0;
+    entry.url = "";
+    entry.etag = "";
+    entry.lastModified = "";
+    entry.body = "";
+  }
+}
+
+QuectelHttpCache::Entry *QuectelHttpCache::_find(uint32_t key,
+                                                 const char *url) {
+  for (size_t i = 0; i < QUECTEL_HTTP_CACHE_SIZE; i++) {
+    if (_entries[i].key == key && _entries[i].url == url) {
+      return &_entries[i];
+    }
+  }
+  return nullptr;
+}
+
+// Filesystem mode: validators stored by an earlier run, if any. The .tag
+// file is "<url>\n<etag>\n<last-modified>\n"; a different URL under the same
+// hash is a miss.
+QuectelHttpCache::Entry *QuectelHttpCache::_load(uint32_t key,
+                                                 const char *url) {
+  char path[48];
+  _path(path, sizeof(path), key, ".tag");
+  // Read-only open fails for a missing file instead of creating it
+  int handle = _modem.fsOpen(path, 2);
+  if (handle < 0) {
+    return nullptr;
+  }
+  String tag;
+  QuectelStringSink sink(tag);
+  int n = _modem.fsReadChunk(handle, sink, 512);
+  _modem.fsClose(handle);
+  if (n <= 0) {
+    return nullptr;
+  }
+  int first = tag.indexOf('\n');
+  int nl = first < 0 ? -1 : tag.indexOf('\n', first + 1);
+  if (nl < 0 || tag.substring(0, first) != url) {
+    return nullptr;
+  }
+  Entry &entry = _entries[_next];
+  _next = (_next + 1) % QUECTEL_HTTP_CACHE_SIZE;
+  entry.key = key;
+  entry.url = url;
+  entry.etag = tag.substring(first + 1, nl);
+  entry.lastModified = tag.substring(nl + 1);
+  entry.lastModified.trim();
+  entry.body = "";
+  return &entry;
+}
+
+void QuectelHttpCache::_store(uint32_t key, const char *url,
+                              const QuectelEC200U::HttpResponse &response) {
+  Entry *entry = _find(key, url);
+  String etag, lastModified, control;
+  _headerValue(response.headers, "ETag", etag);
+  _headerValue(response.headers, "Last-Modified", lastModified);
+  bool noStore = _headerValue(response.headers, "Cache-Control", control) &&
+                 control.indexOf(F("no-store")) != -1;
+  if ((etag.length() == 0 && lastModified.length() == 0) || noStore ||
+      response.body.length() == 0) {
+    if (entry != nullptr) {
+      entry->key = 0;
+    }
+    return;
+  }
+
+  if (entry == nullptr) {
+    entry = &_entries[_next];
+    _next = (_next + 1) % QUECTEL_HTTP_CACHE_SIZE;
+  }
+  entry->key = key;
+  entry->url = url;
+  entry->etag = etag;
+  entry->lastModified = lastModified;
+  if (_fsPrefix == nullptr) {
+    entry->body = response.body;
+    return;
+  }
+
+  // The files are named by hash; an entry for a colliding URL loses them
+  for (size_t i = 0; i < QUECTEL_HTTP_CACHE_SIZE; i++) {
+    if (&_entries[i] != entry && _entries[i].key == key) {
+      _entries[i].key = 0;
+    }
+  }
+
+  // QFUPL refuses to overwrite, so replace the files
+  char path[48];
+  _path(path, sizeof(path), key, ".bin");
+  _modem.fsDelete(path);
+  bool ok = _modem.fsUpload(path, (const uint8_t *)response.body.c_str(),
+                            response.body.length());
+  _path(path, sizeof(path), key, ".tag");
+  _modem.fsDelete(path);
+  String tag = String(url) + "\n" + etag + "\n" + lastModified + "\n";
+  ok = ok && _modem.fsUpload(path, tag.c_str());
+  if (!ok) {
+    entry->key = 0;
+  }
+}
+
+bool QuectelHttpCache::_readBody(const Entry &entry, String &body) {
+  if (_fsPrefix == nullptr) {
+    body = entry.body;
+    return true;
+  }
+  char path[48];
+  _path(path, sizeof(path), entry.key, ".bin");
+  QuectelStringSink sink(body);
+  return _modem.fsRead(path, sink) && body.length() > 0;
+}
+
+void QuectelHttpCache::_path(char *buf, size_t size, uint32_t key,
+                             const char *suffix) const {
+  snprintf(buf, size, "%s%08lx%s", _fsPrefix, (unsigned long)key, suffix);
+}
+
+uint32_t QuectelHttpCache::_hashUrl(const char *url) {
+  uint32_t hash = 2166136261u;
+  while (*url) {
+    hash = (hash ^ (uint8_t)*url++) * 16777619u;
+  }
+  return hash ? hash : 1;
+}
+
+// Case-insensitive lookup in a raw "Name: value\r\n..." header block
+bool QuectelHttpCache::_headerValue(const String &headers, const char *name,
+                                    String &value) {
+  size_t nameLen = strlen(name);
+  const char *line = headers.c_str();
+  while (*line) {
+    const char *end = strchr(line, '\n');
+    if (end == NULL) {
+      end = line + strlen(line);
+    }
+    if (strncasecmp(line, name, nameLen) == 0 && line[nameLen] == ':') {
+      const char *start = line + nameLen + 1;
+      while (start < end && *start == ' ') {
+        start++;
+      }
+      const char *stop = end;
+      while (stop > start && (stop[-1] == '\r' || stop[-1] == ' ')) {
+        stop--;
+      }
+      value = "";
+      value.reserve(stop - start);
+      while (start < stop) {
+        value += *start++;
+      }
+      return true;
+    }
+    line = *end ? end + 1 : end;
+  }
+  return false;
+}
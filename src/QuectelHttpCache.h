@@ -0,0 +1,69 @@
+// src/QuectelHttpCache.h
+
+#ifndef QUECTEL_HTTP_CACHE_H
+#define QUECTEL_HTTP_CACHE_H
+
+#include "QuectelEC200U.h"
+#include "QuectelHttpClient.h"
+#include <Arduino.h>
+
+#ifndef QUECTEL_HTTP_CACHE_SIZE
+#define QUECTEL_HTTP_CACHE_SIZE 4
+#endif
+// Caller headers plus If-None-Match and If-Modified-Since
+#ifndef QUECTEL_HTTP_CACHE_MAX_HEADERS
+#define QUECTEL_HTTP_CACHE_MAX_HEADERS 8
+#endif
+
+// Conditional GET cache for polled URLs. For each URL it keeps the
+// ETag / Last-Modified validators and the last body, sends If-None-Match /
+// If-Modified-Since on the next fetch and answers a 304 from the cache, so
+// an unchanged resource costs a header exchange instead of a full download.
+//
+// Bodies are kept in RAM by default. With a filesystem prefix (e.g.
+// "UFS:hc_") validators and bodies are stored on the modem with fsUpload
+// instead, which keeps RAM free and survives an MCU reset.
+class QuectelHttpCache {
+public:
+  explicit QuectelHttpCache(QuectelEC200U &modem, const char *fsPrefix = nullptr);
+
+  // Fetches url (https:// selects the SSL context) into body. Returns true
+  // for a 200, or a 304 answered from the cache; fromCache tells which.
+  bool get(const char *url, String &body, String headers[] = nullptr,
+           size_t header_size = 0, bool *fromCache = nullptr);
+
+  // Drops every entry (and its files in filesystem mode)
+  void clear();
+
+  uint32_t hits() const { return _hits; }
+  uint32_t misses() const { return _misses; }
+
+private:
+  struct Entry {
+    uint32_t key; // FNV-1a of the URL, 0 = free
+    String url;   // guards against a hash collision
+    String etag;
+    String lastModified;
+    String body;  // RAM mode only
+  };
+
+  QuectelEC200U &_modem;
+  QuectelHttpClient _client;
+  const char *_fsPrefix;
+  Entry _entries[QUECTEL_HTTP_CACHE_SIZE];
+  uint8_t _next;
+  uint32_t _hits;
+  uint32_t _misses;
+
+  Entry *_find(uint32_t key, const char *url);
+  Entry *_load(uint32_t key, const char *url);
+  void _store(uint32_t key, const char *url,
+              const QuectelEC200U::HttpResponse &response);
+  bool _readBody(const Entry &entry, String &body);
+  void _path(char *buf, size_t size, uint32_t key, const char *suffix) const;
+  static uint32_t _hashUrl(const char *url);
+  static bool _headerValue(const String &headers, const char *name,
+                           String &value);
+};
+
+#endif
@@ -0,0 +1,263 @@
+// src/QuectelHttpClient.cpp
+
+#include "QuectelHttpClient.h"
+
+QuectelHttpClient::QuectelHttpClient(QuectelEC200U &modem, int contextId,
+                                     int sslContextId)
+    : _modem(modem), _contextId(contextId), _sslContextId(sslContextId) {
+  invalidate();
+}
+
+void QuectelHttpClient::invalidate() {
+  _epoch = _modem._httpEpoch;
+  _contextSet = false;
+  _sslSet = false;
+  _headersKnown = false;
+  _headerLines = "";
+  _url = "";
+}
+
+bool QuectelHttpClient::get(const char *url, String &response,
+                            String headers[], size_t header_size) {
+  response = "";
+  QuectelStringSink sink(response);
+  return _request(url, NULL, false, sink, headers, header_size) &&
+         response.length() > 0;
+}
+
+bool QuectelHttpClient::get(const char *url, Print &sink, String headers[],
+                            size_t header_size) {
+  return _request(url, NULL, false, sink, headers, header_size);
+}
+
+bool QuectelHttpClient::post(const char *url, const char *data,
+                             String &response, String headers[],
+                             size_t header_size) {
+  response = "";
+  QuectelStringSink sink(response);
+  return _request(url, data, true, sink, headers, header_size) &&
+         response.length() > 0;
+}
+
+bool QuectelHttpClient::post(const char *url, const char *data, Print &sink,
+                             String headers[], size_t header_size) {
+  return _request(url, data, true, sink, headers, header_size);
+}
+
+bool QuectelHttpClient::get(const char *url,
+                            QuectelEC200U::HttpResponse &response,
+                            bool withHeaders, String headers[],
+                            size_t header_size) {
+  return _request(url, NULL, false, response, withHeaders, headers,
+                  header_size);
+}
+
+bool QuectelHttpClient::post(const char *url, const char *data,
+                             QuectelEC200U::HttpResponse &response,
+                             bool withHeaders, String headers[],
+                             size_t header_size) {
+  return _request(url, data, true, response, withHeaders, headers,
+                  header_size);
+}
+
+namespace {
+struct ArrayBatch {
+  QuectelHttpRequest *requests;
+  size_t count;
+  size_t next;
+};
+
+QuectelHttpRequest *nextInArray(void *arg) {
+  ArrayBatch *batch = static_cast<ArrayBatch *>(arg);
+  return batch->next < batch->count ? &batch->requests[batch->next++] : NULL;
+}
+} // namespace
+
+size_t QuectelHttpClient::batch(QuectelHttpRequest *requests, size_t count,
+                                String headers[], size_t header_size) {
+  ArrayBatch source = {requests, count, 0};
+  return batch(nextInArray, &source, headers, header_size);
+}
+
+size_t QuectelHttpClient::batch(QuectelHttpProducer produce, void *arg,
+                                String headers[], size_t header_size) {
+#if defined(QUECTEL_HAS_WORKER)
+  _modem.lock();
+#endif
+  size_t succeeded = 0;
+  QuectelHttpRequest *request = produce(arg);
+  while (request != NULL) {
+    request->ok = false;
+    request->status = -1;
+    bool isPost = request->data != NULL;
+    bool issued = _prepare(request->url, headers, header_size, false) &&
+                  _modem._issueHttpRequest(
+                      request->data, isPost ? strlen(request->data) : 0,
+                      isPost);
+    // Build the next request while the modem waits for the server
+    QuectelHttpRequest *next = produce(arg);
+    if (_complete(*request, issued)) {
+      succeeded++;
+    }
+    request = next;
+  }
+#if defined(QUECTEL_HAS_WORKER)
+  _modem.unlock();
+#endif
+  return succeeded;
+}
+
+bool QuectelHttpClient::_complete(QuectelHttpRequest &request, bool issued) {
+  if (!issued || !_modem._awaitHttpResponse(request.data != NULL)) {
+    invalidate();
+    return false;
+  }
+  request.status = _modem._httpStatus;
+  if (request.response != NULL &&
+      !_modem._readHttpBody(*request.response, 60000,
+                            _modem._httpContentLength)) {
+    _modem._lastError = ErrorCode::HTTP_READ_FAILED;
+    return false;
+  }
+  _modem._lastError = ErrorCode::NONE;
+  request.ok = true;
+  return true;
+}
+
+bool QuectelHttpClient::_request(const char *url, const char *data,
+                                 bool isPost, Print &sink, String headers[],
+                                 size_t header_size) {
+#if defined(QUECTEL_HAS_WORKER)
+  _modem.lock();
+#endif
+  bool ok = _prepare(url, headers, header_size, false) &&
+            _modem._submitHttpRequest(data, data ? strlen(data) : 0, isPost);
+  if (!ok) {
+    // A failed step leaves the modem state unknown
+    invalidate();
+  } else if (!_modem._readHttpBody(sink, 60000, _modem._httpContentLength)) {
+    _modem._lastError = ErrorCode::HTTP_READ_FAILED;
+    ok = false;
+  } else {
+    _modem._lastError = ErrorCode::NONE;
+  }
+#if defined(QUECTEL_HAS_WORKER)
+  _modem.unlock();
+#endif
+  return ok;
+}
+
+bool QuectelHttpClient::_request(const char *url, const char *data,
+                                 bool isPost,
+                                 QuectelEC200U::HttpResponse &response,
+                                 bool withHeaders, String headers[],
+                                 size_t header_size) {
+#if defined(QUECTEL_HAS_WORKER)
+  _modem.lock();
+#endif
+  response.status = -1;
+  response.contentLength = -1;
+  response.headers = "";
+  response.body = "";
+  bool ok = _prepare(url, headers, header_size, withHeaders) &&
+            _modem._submitHttpRequest(data, data ? strlen(data) : 0, isPost);
+  if (!ok) {
+    invalidate();
+  } else if (!_modem._readHttpResponse(response, withHeaders, 60000)) {
+    _modem._lastError = ErrorCode::HTTP_READ_FAILED;
+    ok = false;
+  } else {
+    _modem._lastError = ErrorCode::NONE;
+  }
+#if defined(QUECTEL_HAS_WORKER)
+  _modem.unlock();
+#endif
+  return ok;
+}
+
+bool QuectelHttpClient::_prepare(const char *url, String headers[],
+                                 size_t header_size, bool withHeaders) {
+  // Another HTTP call on the modem rewrote the configuration. Each write
+  // below takes a new epoch, so a client that finds the epoch unchanged
+  // knows nobody touched the modem since its own last write.
+  if (_epoch != _modem._httpEpoch) {
+    invalidate();
+  }
+
+  if (!_contextSet) {
+    if (!_modem.sendAT(ATCommand("AT+QHTTPCFG=\"contextid\",%d", _contextId))) {
+      _modem._lastError = ErrorCode::HTTP_CONTEXT_ID_FAILED;
+      return false;
+    }
+    _contextSet = true;
+    _epoch = ++_modem._httpEpoch;
+  }
+
+  if (!_sslSet && strncmp(url, "https:", 6) == 0) {
+    if (!_modem.sendAT(
+            ATCommand("AT+QHTTPCFG=\"sslctxid\",%d", _sslContextId))) {
+      _modem._lastError = ErrorCode::HTTP_SSL_CONTEXT_ID_FAILED;
+      return false;
+    }
+    _sslSet = true;
+    _epoch = ++_modem._httpEpoch;
+  }
+
+  if (headers == nullptr) {
+    header_size = 0;
+  }
+  if (!_headersKnown || !_sameHeaders(headers, header_size)) {
+    bool sent = header_size > 0
+                    ? _modem._sendHttpHeaders(headers, header_size)
+                    : _modem.sendAT("AT+QHTTPCFG=\"requestheader\",0");
+    if (!sent) {
+      // Some of the headers may have gone through
+      invalidate();
+      _modem._lastError = ErrorCode::HTTP_ERROR;
+      return false;
+    }
+    _headersKnown = true;
+    _keepHeaders(headers, header_size);
+    _epoch = ++_modem._httpEpoch;
+  }
+
+  if (_modem._responseHeaderOn != withHeaders) {
+    if (!_modem._setResponseHeader(withHeaders)) {
+      return false;
+    }
+    _epoch = ++_modem._httpEpoch;
+  }
+
+  if (_url != url) {
+    _url = url;
+    if (!_modem._uploadHttpUrl(_url.c_str(), _url.length())) {
+      return false;
+    }
+    _epoch = ++_modem._httpEpoch;
+  }
+  return true;
+}
+
+// Compared line by line, so no copy is made while the headers stay the same
+bool QuectelHttpClient::_sameHeaders(String headers[],
+                                     size_t header_size) const {
+  const char *p = _headerLines.c_str();
+  const char *end = p + _headerLines.length();
+  for (size_t i = 0; i < header_size; i++) {
+    size_t n = headers[i].length();
+    if ((size_t)(end - p) < n + 1 || memcmp(p, headers[i].c_str(), n) != 0 ||
+        p[n] != '\n') {
+      return false;
+    }
+    p += n + 1;
+  }
+  return p == end;
+}
+
+void QuectelHttpClient::_keepHeaders(String headers[], size_t header_size) {
+  _headerLines = "";
+  for (size_t i = 0; i < header_size; i++) {
+    _headerLines += headers[i];
+    _headerLines += '\n';
+  }
+}
@@ -0,0 +1,86 @@
+// src/QuectelHttpClient.h
+
+#ifndef QUECTEL_HTTP_CLIENT_H
+#define QUECTEL_HTTP_CLIENT_H
+
+#include "QuectelEC200U.h"
+#include <Arduino.h>
+
+// One request of a QuectelHttpClient::batch()
+struct QuectelHttpRequest {
+  const char *url;
+  const char *data; // POST body, or NULL for a GET
+  Print *response;  // body sink, or NULL to skip AT+QHTTPREAD entirely
+  bool ok;          // set by batch()
+  int status;       // HTTP status from the +QHTTPGET/+QHTTPPOST URC, or -1
+};
+
+// Returns the next request of a batch, or NULL when there are no more
+typedef QuectelHttpRequest *(*QuectelHttpProducer)(void *arg);
+
+// HTTP(S) session on top of QuectelEC200U. It remembers the QHTTPCFG
+// settings, custom headers and URL it has already given the modem and only
+// sends what changed, so repeated requests to one endpoint cost just the
+// GET/POST and the body read. https:// URLs select the SSL context.
+class QuectelHttpClient {
+public:
+  explicit QuectelHttpClient(QuectelEC200U &modem, int contextId = 1,
+                             int sslContextId = 1);
+
+  bool get(const char *url, String &response, String headers[] = nullptr,
+           size_t header_size = 0);
+  bool get(const char *url, Print &sink, String headers[] = nullptr,
+           size_t header_size = 0);
+  bool post(const char *url, const char *data, String &response,
+            String headers[] = nullptr, size_t header_size = 0);
+  bool post(const char *url, const char *data, Print &sink,
+            String headers[] = nullptr, size_t header_size = 0);
+  // Status, length and (with withHeaders) response headers; see
+  // QuectelEC200U::HttpResponse
+  bool get(const char *url, QuectelEC200U::HttpResponse &response,
+           bool withHeaders = false, String headers[] = nullptr,
+           size_t header_size = 0);
+  bool post(const char *url, const char *data,
+            QuectelEC200U::HttpResponse &response, bool withHeaders = false,
+            String headers[] = nullptr, size_t header_size = 0);
+
+  // Runs requests back to back over one session and returns how many
+  // succeeded. produce() is called for request n+1 while request n waits
+  // for its URC, so building the next URL/body overlaps the network round
+  // trip. By then request n's URL and body have already been written to the
+  // modem and their buffers may be reused; request n itself must stay valid
+  // until its ok/status are filled in, before produce() is called again.
+  size_t batch(QuectelHttpProducer produce, void *arg,
+               String headers[] = nullptr, size_t header_size = 0);
+  size_t batch(QuectelHttpRequest *requests, size_t count,
+               String headers[] = nullptr, size_t header_size = 0);
+
+  // Forget what the modem is believed to hold (e.g. after a modem reset);
+  // the next request re-sends the full configuration
+  void invalidate();
+
+private:
+  QuectelEC200U &_modem;
+  int _contextId;
+  int _sslContextId;
+  uint16_t _epoch;
+  bool _contextSet;
+  bool _sslSet;
+  bool _headersKnown;
+  // Custom header lines last sent, each ended by '\n'
+  String _headerLines;
+  String _url;
+
+  bool _request(const char *url, const char *data, bool isPost, Print &sink,
+                String headers[], size_t header_size);
+  bool _request(const char *url, const char *data, bool isPost,
+                QuectelEC200U::HttpResponse &response, bool withHeaders,
+                String headers[], size_t header_size);
+  bool _prepare(const char *url, String headers[], size_t header_size,
+                bool withHeaders);
+  bool _complete(QuectelHttpRequest &request, bool issued);
+  bool _sameHeaders(String headers[], size_t header_size) const;
+  void _keepHeaders(String headers[], size_t header_size);
+};
+
+#endif
@@ -0,0 +1,356 @@
+// src/QuectelSocketManager.cpp
+
+#include "QuectelSocketManager.h"
+
+#if defined(QUECTEL_HAS_WORKER)
+#define SOCKET_LOCK() QuectelEC200U::LockGuard _socketLock(_modem)
+#else
+#define SOCKET_LOCK() do { } while (0)
+#endif
+
+namespace {
+// Binary-safe Print into a caller buffer
+class ByteSink : public Print {
+public:
+  ByteSink(uint8_t *buffer, size_t size)
+      : _buffer(buffer), _size(size), _used(0) {}
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *data, size_t len) override {
+    size_t n = len < _size - _used ? len : _size - _used;
+    memcpy(_buffer + _used, data, n);
+    _used += n;
+    return len;
+  }
+  using Print::write;
+
+private:
+  uint8_t *_buffer;
+  size_t _size;
+  size_t _used;
+};
+
+class DiscardSink : public Print {
+public:
+  size_t write(uint8_t) override { return 1; }
+  size_t write(const uint8_t *, size_t len) override { return len; }
+  using Print::write;
+};
+} // namespace
+
+QuectelSocketManager::QuectelSocketManager(QuectelEC200U &modem, int contextId)
+    : _modem(modem), _contextId(contextId), _mode(QuectelAccessMode::BUFFER),
+      _next(0), _registered(false), _callback(nullptr), _callbackArg(nullptr) {
+  for (int i = 0; i < QUECTEL_MAX_SOCKETS; i++) {
+    _slots[i].rx = nullptr;
+    _release(i);
+  }
+}
+
+QuectelSocketManager::~QuectelSocketManager() {
+  if (_registered) {
+    _modem.removeURC("+QIURC: \"recv\"");
+    _modem.removeURC("+QIURC: \"closed\"");
+    _modem.removeURC("+QIURC: \"pdpdeact\"");
+  }
+  for (int i = 0; i < QUECTEL_MAX_SOCKETS; i++) {
+    _release(i);
+  }
+}
+
+bool QuectelSocketManager::begin() {
+  _registered = _modem.onURC("+QIURC: \"recv\"", _onRecv, this) &&
+                _modem.onURC("+QIURC: \"closed\"", _onClosed, this) &&
+                _modem.onURC("+QIURC: \"pdpdeact\"", _onPdpDeact, this);
+  return _registered;
+}
+
+int QuectelSocketManager::open(const char *host, int port,
+                               QuectelSocketType type) {
+  SOCKET_LOCK();
+  int id = -1;
+  for (int i = 0; i < QUECTEL_MAX_SOCKETS; i++) {
+    if (_slots[i].state == QuectelSocketState::FREE) {
+      id = i;
+      break;
+    }
+  }
+  if (id < 0) {
+    _modem.logError(F("No free socket"));
+    _modem._lastError = ErrorCode::TCP_ERROR;
+    return -1;
+  }
+
+  bool push = _mode == QuectelAccessMode::DIRECT_PUSH;
+  if (push) {
+    // Allocated first, so running out of heap never strands an open socket
+    _slots[id].rx = (uint8_t *)malloc(QUECTEL_PUSH_RX_BUFFER);
+    if (!_slots[id].rx) {
+      _modem.logError(F("Socket buffer allocation failed"));
+      _modem._lastError = ErrorCode::TCP_ERROR;
+      return -1;
+    }
+  }
+
+  if (!_modem.sendAT(ATCommand("AT+QIOPEN=%d,%d,\"%s\",\"%s\",%d,0,%d",
+                               _contextId, id,
+                               type == QuectelSocketType::UDP ? "UDP" : "TCP",
+                               host, port, push ? 1 : 0),
+                     "OK", 5000)) {
+    _release(id);
+    _modem._lastError = ErrorCode::TCP_ERROR;
+    return -1;
+  }
+
+  // "+QIOPEN: <id>,<err>"
+  char tag[16];
+  snprintf(tag, sizeof(tag), "+QIOPEN: %d,", id);
+  char urc[64];
+  QuectelBufferSink sink(urc, sizeof(urc));
+  _modem._readUntil(sink, 15000, AT_TERM_EXPECT, tag);
+  if (!_modem._expectSeen || _modem._parseCsvInt(urc, tag, 0) != 0) {
+    _modem.logError(String(F("Socket open failed: ")) + urc);
+    _modem._lastError = ErrorCode::TCP_ERROR;
+    // The modem keeps a failed ID allocated until it is closed
+    _modem.sendAT(ATCommand("AT+QICLOSE=%d", id), "OK", 5000);
+    _release(id);
+    return -1;
+  }
+  _slots[id].state = QuectelSocketState::OPEN;
+  _slots[id].pending = false;
+  _modem._lastError = ErrorCode::NONE;
+  return id;
+}
+
+bool QuectelSocketManager::send(int socketId, const uint8_t *data,
+                                size_t length) {
+  SOCKET_LOCK();
+  if (!_valid(socketId) || _slots[socketId].state != QuectelSocketState::OPEN) {
+    _modem._lastError = ErrorCode::TCP_ERROR;
+    return false;
+  }
+  return _modem.tcpSend(socketId, data, length);
+}
+
+int QuectelSocketManager::read(int socketId, uint8_t *buffer, size_t size) {
+  SOCKET_LOCK();
+  if (!_valid(socketId) || _slots[socketId].state == QuectelSocketState::FREE ||
+      size == 0) {
+    _modem._lastError = ErrorCode::TCP_ERROR;
+    return -1;
+  }
+  // A transparent session owns the UART; AT+QIRD would go to its peer
+  if (!_modem._commandAllowed()) {
+    return -1;
+  }
+  if (_slots[socketId].rx) {
+    return _readPushed(_slots[socketId], buffer, size);
+  }
+  // "+QIRD: <n>\r\n<n bytes>\r\n\r\nOK"; the data is copied unscanned
+  if (!_modem.sendATRaw(ATCommand("AT+QIRD=%d,%u", socketId, (unsigned)size))) {
+    return -1;
+  }
+  char head[32];
+  QuectelBufferSink sink(head, sizeof(head));
+  _modem._readUntil(sink, 5000, AT_TERM_DEFAULT | AT_TERM_EXPECT, "+QIRD: ");
+  if (!_modem._expectSeen) {
+    _modem._lastError = ErrorCode::TCP_ERROR;
+    return -1;
+  }
+  int n = _modem._parseCsvInt(head, "+QIRD: ", 0);
+  if (n < 0 || (size_t)n > size) {
+    _modem._lastError = ErrorCode::TCP_ERROR;
+    return -1;
+  }
+  ByteSink out(buffer, size);
+  size_t got = _modem._readRaw(out, n, 5000);
+  DiscardSink rest;
+  _modem._readUntil(rest, 1000, AT_TERM_DEFAULT);
+  if (got != (size_t)n) {
+    _modem._lastError = ErrorCode::TCP_ERROR;
+    return -1;
+  }
+  // A short read drained the modem's buffer; the next data brings a new URC
+  if ((size_t)n < size) {
+    _slots[socketId].pending = false;
+  }
+  _modem._lastError = ErrorCode::NONE;
+  return n;
+}
+
+bool QuectelSocketManager::close(int socketId) {
+  SOCKET_LOCK();
+  if (!_valid(socketId) || _slots[socketId].state == QuectelSocketState::FREE) {
+    return false;
+  }
+  bool ok = _modem.sendAT(ATCommand("AT+QICLOSE=%d", socketId), "OK", 10000);
+  // Free the slot either way; a socket the modem still holds fails to reopen
+  // and is closed again then
+  _release(socketId);
+  return ok;
+}
+
+void QuectelSocketManager::closeAll() {
+  for (int i = 0; i < QUECTEL_MAX_SOCKETS; i++) {
+    if (_slots[i].state != QuectelSocketState::FREE) {
+      close(i);
+    }
+  }
+}
+
+void QuectelSocketManager::poll() { _modem.poll(); }
+
+int QuectelSocketManager::available() {
+  for (int i = 0; i < QUECTEL_MAX_SOCKETS; i++) {
+    int id = (_next + i) % QUECTEL_MAX_SOCKETS;
+    if (_slots[id].pending && _slots[id].state != QuectelSocketState::FREE) {
+      _next = (id + 1) % QUECTEL_MAX_SOCKETS;
+      return id;
+    }
+  }
+  return -1;
+}
+
+bool QuectelSocketManager::hasData(int socketId) const {
+  return _valid(socketId) && _slots[socketId].pending;
+}
+
+QuectelSocketState QuectelSocketManager::state(int socketId) const {
+  return _valid(socketId) ? _slots[socketId].state : QuectelSocketState::FREE;
+}
+
+size_t QuectelSocketManager::dropped(int socketId) const {
+  return _valid(socketId) ? _slots[socketId].dropped : 0;
+}
+
+size_t QuectelSocketManager::openCount() const {
+  size_t count = 0;
+  for (int i = 0; i < QUECTEL_MAX_SOCKETS; i++) {
+    if (_slots[i].state == QuectelSocketState::OPEN) {
+      count++;
+    }
+  }
+  return count;
+}
+
+void QuectelSocketManager::_release(int socketId) {
+  Slot &slot = _slots[socketId];
+  slot.state = QuectelSocketState::FREE;
+  slot.pending = false;
+  free(slot.rx);
+  slot.rx = nullptr;
+  slot.head = 0;
+  slot.count = 0;
+  slot.dropped = 0;
+}
+
+// Drains the socket's push ring; no AT traffic, only pending URCs
+int QuectelSocketManager::_readPushed(Slot &slot, uint8_t *buffer,
+                                      size_t size) {
+  _modem.poll();
+  size_t total = 0;
+  while (total < size && slot.count > 0) {
+    size_t run = QUECTEL_PUSH_RX_BUFFER - slot.head;
+    if (run > slot.count) {
+      run = slot.count;
+    }
+    if (run > size - total) {
+      run = size - total;
+    }
+    memcpy(buffer + total, slot.rx + slot.head, run);
+    slot.head = (slot.head + run) % QUECTEL_PUSH_RX_BUFFER;
+    slot.count -= run;
+    total += run;
+  }
+  slot.pending = slot.count > 0;
+  _modem._lastError = ErrorCode::NONE;
+  return (int)total;
+}
+
+size_t QuectelSocketManager::PushSink::write(const uint8_t *data, size_t len) {
+  // No ring to take it: unknown socket, or closed while its data was still
+  // arriving. Dropped, but still consumed from the UART.
+  if (slot == nullptr || !slot->rx) {
+    return len;
+  }
+  size_t room = QUECTEL_PUSH_RX_BUFFER - slot->count;
+  size_t n = len < room ? len : room;
+  slot->dropped += len - n;
+  for (size_t done = 0; done < n;) {
+    size_t tail = (slot->head + slot->count) % QUECTEL_PUSH_RX_BUFFER;
+    size_t run = QUECTEL_PUSH_RX_BUFFER - tail;
+    if (run > n - done) {
+      run = n - done;
+    }
+    memcpy(slot->rx + tail, data + done, run);
+    slot->count += run;
+    done += run;
+  }
+  if (n > 0) {
+    slot->pending = true;
+  }
+  return len;
+}
+
+// Numeric field of "+QIURC: "<kind>",<id>[,<len>...]", or -1
+long QuectelSocketManager::_urcField(const char *line, int index) {
+  ATTokenizer fields(line, "+QIURC:");
+  ATField field;
+  if (!fields.field(index, field) || field.len == 0) {
+    return -1;
+  }
+  return field.toInt();
+}
+
+void QuectelSocketManager::_onRecv(const char *line, void *arg) {
+  QuectelSocketManager *self = static_cast<QuectelSocketManager *>(arg);
+  int id = (int)_urcField(line, 1);
+  Slot *slot = self->_valid(id) &&
+                       self->_slots[id].state != QuectelSocketState::FREE
+                   ? &self->_slots[id]
+                   : nullptr;
+  // Direct push: "+QIURC: "recv",<id>,<len>" and then the data itself. The
+  // payload is taken off the UART whoever owns it, so peer bytes never reach
+  // the AT line parser.
+  long length = _urcField(line, 2);
+  if (length > 0) {
+    self->_pushSink.slot = slot;
+    self->_modem.urcPayload((size_t)length, self->_pushSink);
+  }
+  // Signal only what read() can deliver: pushed data in a ring, or a
+  // buffer mode socket with data waiting for AT+QIRD
+  if (slot == nullptr || (slot->rx != nullptr) != (length > 0)) {
+    return;
+  }
+  slot->pending = true;
+  if (self->_callback) {
+    self->_callback(id, QuectelSocketEvent::DATA, self->_callbackArg);
+  }
+}
+
+void QuectelSocketManager::_onClosed(const char *line, void *arg) {
+  QuectelSocketManager *self = static_cast<QuectelSocketManager *>(arg);
+  int id = (int)_urcField(line, 1);
+  if (!self->_valid(id) || self->_slots[id].state != QuectelSocketState::OPEN) {
+    return;
+  }
+  self->_slots[id].state = QuectelSocketState::CLOSED;
+  if (self->_callback) {
+    self->_callback(id, QuectelSocketEvent::CLOSED, self->_callbackArg);
+  }
+}
+
+// The PDP context went down and took every socket on it
+void QuectelSocketManager::_onPdpDeact(const char *line, void *arg) {
+  QuectelSocketManager *self = static_cast<QuectelSocketManager *>(arg);
+  if (_urcField(line, 1) != self->_contextId) {
+    return;
+  }
+  for (int i = 0; i < QUECTEL_MAX_SOCKETS; i++) {
+    if (self->_slots[i].state == QuectelSocketState::OPEN) {
+      self->_slots[i].state = QuectelSocketState::CLOSED;
+      if (self->_callback) {
+        self->_callback(i, QuectelSocketEvent::CLOSED, self->_callbackArg);
+      }
+    }
+  }
+}
@@ -0,0 +1,132 @@
+// src/QuectelSocketManager.h
+
+#ifndef QUECTEL_SOCKET_MANAGER_H
+#define QUECTEL_SOCKET_MANAGER_H
+
+#include "QuectelEC200U.h"
+#include <Arduino.h>
+
+// The EC200U has connectIDs 0..11
+#ifndef QUECTEL_MAX_SOCKETS
+#define QUECTEL_MAX_SOCKETS 12
+#endif
+
+// Receive ring of each direct-push socket; the modem pushes up to 1500
+// bytes per +QIURC "recv", which is lost if it does not fit
+#ifndef QUECTEL_PUSH_RX_BUFFER
+#define QUECTEL_PUSH_RX_BUFFER 1536
+#endif
+
+enum class QuectelSocketType { TCP, UDP };
+
+// <access_mode> of AT+QIOPEN for the sockets open() creates
+enum class QuectelAccessMode : uint8_t {
+  BUFFER = 0,     // the modem buffers data; read() fetches it with AT+QIRD
+  DIRECT_PUSH = 1 // data follows +QIURC "recv" on the UART; read() copies it
+};
+
+enum class QuectelSocketState : uint8_t {
+  FREE,    // ID available to open()
+  OPEN,    // connected
+  CLOSED   // closed by the peer or the network; close() frees the ID
+};
+
+enum class QuectelSocketEvent : uint8_t { DATA, CLOSED };
+typedef void (*QuectelSocketCallback)(int socketId, QuectelSocketEvent event, void *arg);
+
+// Socket table for several concurrent TCP/UDP connections. It hands out
+// connectIDs, follows each socket's state through the +QIOPEN result and
+// the +QIURC "recv" / "closed" / "pdpdeact" URCs, and tells which sockets
+// have data waiting, so one loop can serve every connection. In direct push
+// mode the data itself arrives with the "recv" URC and is buffered here.
+//
+// Registers three URC handlers (of QUECTEL_MAX_URC_HANDLERS) in begin(); a
+// handler of your own for plain "+QIURC:" still gets the other kinds.
+class QuectelSocketManager {
+public:
+  explicit QuectelSocketManager(QuectelEC200U &modem, int contextId = 1);
+  ~QuectelSocketManager();
+
+  bool begin();
+
+  // Access mode for sockets opened from now on (default BUFFER). In
+  // DIRECT_PUSH mode each socket gets a QUECTEL_PUSH_RX_BUFFER byte ring
+  // that the URC reader fills, so read() sends no AT command at all.
+  void setAccessMode(QuectelAccessMode mode) { _mode = mode; }
+
+  // Opens a connection on a free ID and returns the ID, or -1 when none is
+  // free or the modem refused.
+  int open(const char *host, int port,
+           QuectelSocketType type = QuectelSocketType::TCP);
+  // Any length; split into AT+QISEND segments as tcpSend() does
+  bool send(int socketId, const uint8_t *data, size_t length);
+  bool send(int socketId, const char *data) {
+    return send(socketId, (const uint8_t *)data, strlen(data));
+  }
+  // Reads what the modem has buffered (or pushed) for the socket, at most
+  // size bytes. Returns the byte count (0 when nothing is waiting) or -1 on
+  // error.
+  int read(int socketId, uint8_t *buffer, size_t size);
+  bool close(int socketId);
+  void closeAll();
+
+  // Dispatches pending URCs; call it from loop()
+  void poll();
+  // The next socket with unread data (round robin), or -1
+  int available();
+  bool hasData(int socketId) const;
+  QuectelSocketState state(int socketId) const;
+  size_t openCount() const;
+  // Pushed bytes dropped because the socket's ring was full
+  size_t dropped(int socketId) const;
+
+  // Called from the URC reader when data arrives or a socket closes. It
+  // must not send AT commands; note the ID and serve it from loop().
+  void onEvent(QuectelSocketCallback callback, void *arg = nullptr) {
+    _callback = callback;
+    _callbackArg = arg;
+  }
+
+private:
+  struct Slot {
+    QuectelSocketState state;
+    bool pending; // +QIURC "recv" not drained by read() yet
+    uint8_t *rx;  // direct push ring, NULL in buffer mode
+    size_t head;
+    size_t count;
+    size_t dropped;
+  };
+
+  // Copies one pushed payload into its socket's ring; with no slot (or no
+  // ring) the payload is dropped
+  class PushSink : public Print {
+  public:
+    PushSink() : slot(nullptr) {}
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *data, size_t len) override;
+    using Print::write;
+    Slot *slot;
+  };
+
+  QuectelEC200U &_modem;
+  int _contextId;
+  QuectelAccessMode _mode;
+  Slot _slots[QUECTEL_MAX_SOCKETS];
+  PushSink _pushSink;
+  uint8_t _next;
+  bool _registered;
+  QuectelSocketCallback _callback;
+  void *_callbackArg;
+
+  bool _valid(int socketId) const {
+    return socketId >= 0 && socketId < QUECTEL_MAX_SOCKETS;
+  }
+  void _release(int socketId);
+  static void _onRecv(const char *line, void *arg);
+  static void _onClosed(const char *line, void *arg);
+  static void _onPdpDeact(const char *line, void *arg);
+  int _readPushed(Slot &slot, uint8_t *buffer, size_t size);
+  static long _urcField(const char *line, int index);
+};
+
+#endif
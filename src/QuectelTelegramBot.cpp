@@ -5,26 +5,36 @@
 QuectelTelegramBot::QuectelTelegramBot(const String &token,
                                        QuectelEC200U &modem)
     : _token(token), _modem(modem), last_message_received(0) {
-  _apiUrl = "https://api.telegram.org/bot" + token + "/";
+  _url.reserve(29 + token.length() + 96);
+  _url = "https://api.telegram.org/bot";
+  _url += token;
+  _url += '/';
+  _apiUrlLength = _url.length();
 }
 
-bool QuectelTelegramBot::_sendPost(const String &endpoint,
+const char *QuectelTelegramBot::_endpointUrl(const char *endpoint) {
+  _url.remove(_apiUrlLength);
+  _url += endpoint;
+  return _url.c_str();
+}
+
+bool QuectelTelegramBot::_sendPost(const char *endpoint,
                                    const JsonDocument &payload,
                                    String &response) {
-  String url = _apiUrl + endpoint;
   String headers[] = {"Content-Type: application/json"};
-  return _modem.httpsPost(url.c_str(), payload, response, headers, 1);
+  return _modem.httpsPost(_endpointUrl(endpoint), payload, response, headers,
+                          1);
 }
 
-bool QuectelTelegramBot::_sendGet(const String &endpoint, String &response) {
-  String url = _apiUrl + endpoint;
-  return _modem.httpsGet(url.c_str(), response);
+bool QuectelTelegramBot::_sendGet(const char *endpoint, String &response) {
+  return _modem.httpsGet(_endpointUrl(endpoint), response);
 }
 
 int QuectelTelegramBot::getUpdates(long offset) {
-  String endpoint = "getUpdates?limit=5&allowed_updates=[\"message\"]";
+  char endpoint[80] = "getUpdates?limit=5&allowed_updates=[\"message\"]";
   if (offset > 0) {
-    endpoint += "&offset=" + String(offset);
+    size_t len = strlen(endpoint);
+    snprintf(endpoint + len, sizeof(endpoint) - len, "&offset=%ld", offset);
   }
 
   String response;
@@ -38,11 +38,15 @@ public:
 private:
   String _token;
   QuectelEC200U &_modem;
-  String _apiUrl;
+  // "https://api.telegram.org/bot<token>/" followed by the last endpoint;
+  // reserved once so building a request URL does not allocate
+  String _url;
+  size_t _apiUrlLength;
 
-  bool _sendPost(const String &endpoint, const JsonDocument &payload,
+  const char *_endpointUrl(const char *endpoint);
+  bool _sendPost(const char *endpoint, const JsonDocument &payload,
                  String &response);
-  bool _sendGet(const String &endpoint, String &response);
+  bool _sendGet(const char *endpoint, String &response);
 };
 
 #endif
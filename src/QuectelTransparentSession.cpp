@@ -0,0 +1,166 @@
+// src/QuectelTransparentSession.cpp
+
+#include "QuectelTransparentSession.h"
+
+#if defined(QUECTEL_HAS_WORKER)
+#define SESSION_LOCK() QuectelEC200U::LockGuard _sessionLock(_modem)
+#else
+#define SESSION_LOCK() do { } while (0)
+#endif
+
+namespace {
+class DiscardSink : public Print {
+public:
+  size_t write(uint8_t) override { return 1; }
+  size_t write(const uint8_t *, size_t len) override { return len; }
+  using Print::write;
+};
+} // namespace
+
+QuectelTransparentSession::QuectelTransparentSession(QuectelEC200U &modem)
+    : _modem(modem), _socket(-1), _active(false), _skipLf(false),
+      _lastWrite(0) {}
+
+QuectelTransparentSession::~QuectelTransparentSession() { end(); }
+
+bool QuectelTransparentSession::begin(const char *host, int port, int socketId,
+                                      int contextId, QuectelSocketType type) {
+  SESSION_LOCK();
+  if (_socket >= 0 || _modem._transparent) {
+    _modem._lastError = ErrorCode::TCP_ERROR;
+    return false;
+  }
+  // Transparent mode answers CONNECT (or ERROR) in place of OK / +QIOPEN
+  if (!_enter(ATCommand("AT+QIOPEN=%d,%d,\"%s\",\"%s\",%d,0,2", contextId,
+                        socketId,
+                        type == QuectelSocketType::UDP ? "UDP" : "TCP", host,
+                        port),
+              15000)) {
+    return false;
+  }
+  _socket = socketId;
+  return true;
+}
+
+bool QuectelTransparentSession::attach(int socketId) {
+  SESSION_LOCK();
+  if (_socket >= 0 || _modem._transparent) {
+    _modem._lastError = ErrorCode::TCP_ERROR;
+    return false;
+  }
+  if (!_enter(ATCommand("AT+QISWTMD=%d,2", socketId), 5000)) {
+    return false;
+  }
+  _socket = socketId;
+  return true;
+}
+
+bool QuectelTransparentSession::suspend() {
+  SESSION_LOCK();
+  if (!_active) {
+    return _socket >= 0;
+  }
+  _modem._serial->flush();
+  uint32_t quiet = millis() - _lastWrite;
+  if (quiet < QUECTEL_TRANSPARENT_GUARD_MS) {
+    delay(QUECTEL_TRANSPARENT_GUARD_MS - quiet);
+  }
+  _modem._serial->write((const uint8_t *)"+++", 3);
+  _active = false;
+  _modem._transparent = false;
+
+  // OK follows the trailing guard time; data still in flight before it is
+  // dropped
+  DiscardSink sink;
+  _modem._readUntil(sink, QUECTEL_TRANSPARENT_GUARD_MS + 2000,
+                    AT_TERM_DEFAULT, "OK");
+  if (!_modem._readResult()) {
+    _modem.logError(F("Transparent mode escape failed"));
+    _modem._lastError = ErrorCode::TCP_ERROR;
+    return false;
+  }
+  return true;
+}
+
+bool QuectelTransparentSession::resume() {
+  SESSION_LOCK();
+  if (_active) {
+    return true;
+  }
+  if (_socket < 0 || _modem._transparent) {
+    _modem._lastError = ErrorCode::TCP_ERROR;
+    return false;
+  }
+  return _enter(ATCommand("ATO"), 5000);
+}
+
+bool QuectelTransparentSession::end() {
+  SESSION_LOCK();
+  if (_socket < 0) {
+    return true;
+  }
+  // Close even when the escape went unanswered (e.g. after NO CARRIER)
+  bool ok = suspend();
+  ok = _modem.sendAT(ATCommand("AT+QICLOSE=%d", _socket), "OK", 10000) && ok;
+  _socket = -1;
+  return ok;
+}
+
+int QuectelTransparentSession::available() {
+  if (!_active) {
+    return 0;
+  }
+  _dropLf();
+  return _modem._serial->available();
+}
+
+int QuectelTransparentSession::read() {
+  if (!_active) {
+    return -1;
+  }
+  _dropLf();
+  return _modem._serial->read();
+}
+
+int QuectelTransparentSession::peek() {
+  if (!_active) {
+    return -1;
+  }
+  _dropLf();
+  return _modem._serial->peek();
+}
+
+size_t QuectelTransparentSession::write(const uint8_t *buffer, size_t size) {
+  if (!_active) {
+    return 0;
+  }
+  size_t n = _modem._writePaced(buffer, size);
+  _lastWrite = millis();
+  return n;
+}
+
+void QuectelTransparentSession::flush() { _modem._serial->flush(); }
+
+// Sends a command that ends in CONNECT and hands over the UART
+bool QuectelTransparentSession::_enter(const ATCommand &cmd,
+                                       uint32_t timeout) {
+  if (!_modem.sendAT(cmd, "CONNECT", timeout)) {
+    _modem.logError(F("Transparent mode not entered"));
+    _modem._lastError = ErrorCode::TCP_ERROR;
+    return false;
+  }
+  _active = true;
+  _skipLf = true;
+  _lastWrite = millis();
+  _modem._transparent = true;
+  return true;
+}
+
+void QuectelTransparentSession::_dropLf() {
+  if (_skipLf && _modem._serial->available()) {
+    _skipLf = false;
+    if (_modem._serial->peek() == '\n') {
+      _modem._serial->read();
+    }
+  }
+}
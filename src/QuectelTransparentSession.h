@@ -0,0 +1,69 @@
+// src/QuectelTransparentSession.h
+
+#ifndef QUECTEL_TRANSPARENT_SESSION_H
+#define QUECTEL_TRANSPARENT_SESSION_H
+
+#include "QuectelEC200U.h"
+#include "QuectelSocketManager.h"
+#include <Arduino.h>
+
+// Silence the modem needs on each side of "+++"
+#ifndef QUECTEL_TRANSPARENT_GUARD_MS
+#define QUECTEL_TRANSPARENT_GUARD_MS 1000
+#endif
+
+// One socket in transparent access mode (AT+QIOPEN ...,2): the UART becomes
+// a byte pipe to the peer with no AT+QISEND/AT+QIRD per packet, for bulk
+// transfers at line speed. The modem serves nothing else meanwhile, so the
+// library's own commands, poll() and loop() stand aside until suspend() or
+// end(). Only one session can hold the UART at a time.
+//
+//   QuectelTransparentSession pipe(modem);
+//   if (pipe.begin("example.com", 9000)) {
+//     pipe.write(buf, len);
+//     pipe.end();
+//   }
+//
+// When the peer closes, the modem leaves data mode on its own and prints
+// NO CARRIER into the stream; call end() to release the UART.
+class QuectelTransparentSession : public Stream {
+public:
+  explicit QuectelTransparentSession(QuectelEC200U &modem);
+  ~QuectelTransparentSession();
+
+  // Opens a connection straight into transparent mode
+  bool begin(const char *host, int port, int socketId = 0, int contextId = 1,
+             QuectelSocketType type = QuectelSocketType::TCP);
+  // Switches a socket that is already open into transparent mode
+  bool attach(int socketId);
+  // Escapes with "+++" (a guard time either side); the socket stays open in
+  // buffer access mode. Unread data still in the UART is discarded.
+  bool suspend();
+  // Back into the data phase with ATO
+  bool resume();
+  // Leaves the data phase if needed and closes the socket
+  bool end();
+
+  bool active() const { return _active; }
+  int socketId() const { return _socket; }
+
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t write(uint8_t c) override { return write(&c, 1); }
+  size_t write(const uint8_t *buffer, size_t size) override;
+  using Print::write;
+  void flush() override;
+
+private:
+  QuectelEC200U &_modem;
+  int _socket;
+  bool _active;
+  bool _skipLf; // the LF after CONNECT is still in the UART
+  uint32_t _lastWrite;
+
+  bool _enter(const ATCommand &cmd, uint32_t timeout);
+  void _dropLf();
+};
+
+#endif